@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+struct arenaStats{
+    std::size_t allocations;       // Alocações servidas desde o último reset
+    std::size_t bytes;             // Bytes entregues desde o último reset
+    std::size_t peakBytes;         // Maior 'bytes' já visto em um quadro
+    std::size_t upstreamBlocks;    // Blocos pedidos ao heap desde a criação
+};
+
+// Alocador de pilha (bump) para dados temporários de um quadro. Liberar é no-op;
+// reset() devolve tudo de uma vez. Se um quadro precisou de mais de um bloco, reset()
+// troca todos por um único bloco do tamanho total, então quadros seguintes do mesmo
+// tamanho não tocam mais no heap. Não é thread-safe: pertence à thread que o reseta.
+class frameArena : public std::pmr::memory_resource{
+
+private:
+    struct block{
+        char* data;
+        std::size_t size;
+    };
+
+    std::vector<block> blocks;
+    std::size_t current;    // Bloco em uso
+    std::size_t offset;     // Próximo byte livre do bloco em uso
+    arenaStats stats;
+
+    void addBlock(std::size_t minimum);
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+    explicit frameArena(std::size_t initialSize = 64 * 1024);
+    ~frameArena();
+
+    frameArena(const frameArena&) = delete;
+    frameArena& operator=(const frameArena&) = delete;
+
+    void reset();
+    arenaStats getStats() const;
+};
+
+// Arena do quadro, resetada uma vez por quadro pelo laço de renderização
+frameArena& frameScratch();
+
+// Contagem de alocações: só no build de diagnóstico (make DIAGNOSTICS=-DCOUNT_ALLOCATIONS),
+// que substitui o operator new global. No build normal o operator new é o padrão.
+#ifdef COUNT_ALLOCATIONS
+constexpr bool heapAllocationCounting = true;
+#else
+constexpr bool heapAllocationCounting = false;
+#endif
+
+// Total de chamadas ao operator new global desde o início do programa (sempre 0 sem
+// COUNT_ALLOCATIONS). Comparar o valor antes e depois de um quadro mostra se ele alocou no heap.
+std::size_t heapAllocationCount();
@@ -0,0 +1,16 @@
+#pragma once
+#include "options.h"
+#include "workload.h"
+
+// Modos sem janela, que medem ou conferem uma parte do pipeline e saem. A nuvem vem
+// de --scan (só 3D) ou é gerada com 'workload'. Retornam o código de saída do programa.
+
+// --bench3d: transformação em lote, construção de AABB3, esferas e OBB3 e pares, com
+// uma thread e com o pool
+int runBench3D(const runOptions& options, const workloadSpec& workload);
+
+// --check-precision: o pipeline 3D em float contra o de double (ver volumes3d.h)
+int runCheckPrecision(const runOptions& options, const workloadSpec& workload);
+
+// --quantize: a nuvem 2D quantizada em 16 ou 32 bits contra a original em double
+int runQuantized(const runOptions& options, const workloadSpec& workload);
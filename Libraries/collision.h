@@ -0,0 +1,72 @@
+#pragma once
+#include "point.h"
+#include "volumes.h"
+#include "parallel.h"
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Contato entre os volumes i e j (sempre i < j)
+struct contact{
+    int i;
+    int j;
+    ponto2D points[8];  // Pontos de contato (cruzamentos das bordas)
+    int count;
+    double depth;       // Penetração ao longo da normal
+    ponto2D normal;     // Unitária, apontando de i para j
+};
+
+// Lista de contatos reutilizável: clear() não libera memória, então depois dos
+// primeiros quadros os testes não alocam mais nada.
+class contactBuffer{
+
+private:
+    std::vector<contact> items;
+    std::size_t used;
+    std::vector<std::vector<contact>> scratch; // Saída de cada bloco na versão paralela
+
+public:
+    contactBuffer();
+
+    void reserve(std::size_t count);
+    void clear();
+    contact& push();
+
+    std::size_t size() const;
+    bool empty() const;
+    const contact& operator[](std::size_t k) const;
+    const contact* begin() const;
+    const contact* end() const;
+
+    // Usado pelos testes paralelos: uma lista vazia por bloco, e depois a junção
+    // de todas em ordem de (i, j).
+    std::vector<std::vector<contact>>& tiles(std::size_t count);
+    void mergeTiles();
+};
+
+// Cada par não ordenado é testado uma única vez e os contatos substituem o conteúdo
+// de 'out'. Com pool != nullptr o triângulo superior é dividido em blocos e
+// processado em paralelo; a ordem do resultado é a mesma da versão serial.
+// Dados temporários (SoA, lista de blocos) vêm de 'scratch', normalmente a arena do quadro.
+void intersectAABBs(const std::vector<aabb2D>& boxes, contactBuffer& out, threadPool* pool = nullptr, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+void intersectCircles(const std::vector<circle2D>& circles, contactBuffer& out, threadPool* pool = nullptr, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+void intersectOBBs(const std::vector<obb2D>& boxes, contactBuffer& out, threadPool* pool = nullptr, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+void intersectCapsules(const std::vector<capsule2D>& capsules, contactBuffer& out, threadPool* pool = nullptr, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+// Um contato por par: o ponto de cada elipse mais fundo na outra. A profundidade é uma
+// estimativa (quanto o ponto de j entra em i, na métrica de i, vezes o menor semi-eixo de i).
+void intersectEllipses(const std::vector<ellipse2D>& ellipses, contactBuffer& out, threadPool* pool = nullptr, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+// k-DOPs: o teste de faixas (sem desvios) descarta os pares separados, e só os que
+// passam têm as bordas dos polígonos cruzadas para os pontos de contato (até 8).
+// depth e normal vêm do eixo de menor sobreposição.
+void intersectDOP8s(const std::vector<dop8>& dops, contactBuffer& out, threadPool* pool = nullptr, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+void intersectDOP16s(const std::vector<dop16>& dops, contactBuffer& out, threadPool* pool = nullptr, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+// Volumes de tipos misturados (seleção automática). Pares do mesmo tipo usam o teste
+// específico, com pontos de contato; pares de tipos diferentes usam GJK sobre as
+// funções suporte e só informam a sobreposição (count = 0, normal entre os centros).
+void intersectVolumes(const std::vector<taggedVolume>& volumes, contactBuffer& out, threadPool* pool = nullptr, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+// GJK em 2D: os volumes convexos a e b se sobrepõem (encostados contam)
+bool gjkOverlap(const taggedVolume& a, const taggedVolume& b);
@@ -0,0 +1,14 @@
+#pragma once
+#include "volumes3d.h"
+#include <cstddef>
+
+// Reduções de min/max dos construtores 3D. Ficam numa unidade própria, compilada com
+// -ffinite-math-only -fno-signed-zeros (ver makefile): sem isso o GCC não vetoriza
+// std::min/std::max, e as flags não devem valer para o resto de volumes3d.cpp
+// (leitura de arquivos, Jacobi, Welzl).
+
+// Menores e maiores projeções de [first, last) - origin nos três eixos. Os intervalos
+// começam em [0, 0], então sempre contêm a origem.
+template<typename T>
+void projectedExtents3(const cloud3<T>& cloud, std::size_t first, std::size_t last, const vector3<T>& origin,
+                       const vector3<T> axes[3], T lo[3], T hi[3]);
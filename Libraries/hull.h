@@ -0,0 +1,25 @@
+#pragma once
+#include "point.h"
+#include "parallel.h"
+#include <memory_resource>
+#include <vector>
+
+// Fecho convexo pela cadeia monótona de Andrew, com os testes de orientação
+// robustos de predicates.h. O resultado está em sentido anti-horário, começa no
+// ponto de menor (x, y) e não tem pontos colineares nem repetidos. Conjuntos
+// degenerados devolvem 1 ponto (todos iguais) ou 2 (todos colineares).
+//
+// Acima de algumas dezenas de pontos, o filtro de Akl–Toussaint descarta antes da
+// ordenação os pontos estritamente dentro do octógono dos 8 pontos extremos.
+//
+// Com 'pool' e conjuntos grandes, divide e conquista: cada thread faz o fecho de um
+// pedaço e o fecho final é o fecho da união dos fechos parciais.
+std::vector<ponto2D> convexHull(const std::vector<ponto2D>& points, threadPool* pool = nullptr,
+                                std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+// Um fecho por subconjunto de 'cloud', em paralelo por subconjunto quando há 'pool'
+void computeHulls(const std::vector<std::vector<ponto2D>>& cloud, std::vector<std::vector<ponto2D>>& hulls, threadPool* pool = nullptr);
+
+// p está dentro ou na borda do polígono convexo anti-horário 'hull'. O(log n): busca
+// binária da cunha em torno de hull[0] que contém p e um teste contra a aresta dela.
+bool pointInConvexPolygon(const std::vector<ponto2D>& hull, const ponto2D& p);
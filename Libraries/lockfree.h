@@ -0,0 +1,173 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Estruturas sem trava para passar dados entre threads. Os índices de cada lado ficam
+// em linhas de cache separadas, para que produtores e consumidores não disputem a
+// mesma linha a cada operação.
+
+constexpr std::size_t cacheLine = 64;
+
+// Fila circular de um produtor e um consumidor (SPSC) com capacidade fixa (potência
+// de 2). push e pop nunca bloqueiam: retornam false com a fila cheia ou vazia. Cada
+// lado guarda uma cópia do índice do outro e só relê o atômico quando ela se esgota.
+template<typename T, std::size_t Capacity>
+class spscQueue{
+
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacidade deve ser potencia de 2");
+
+private:
+    // Lado do consumidor
+    alignas(cacheLine) std::atomic<std::size_t> head{0};
+    std::size_t cachedTail = 0;
+
+    // Lado do produtor
+    alignas(cacheLine) std::atomic<std::size_t> tail{0};
+    std::size_t cachedHead = 0;
+
+    alignas(cacheLine) T items[Capacity];
+
+public:
+    // Só o produtor chama
+    bool push(const T& item){
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if(t - cachedHead == Capacity){
+            cachedHead = head.load(std::memory_order_acquire);
+            if(t - cachedHead == Capacity){
+                return false;
+            }
+        }
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Só o consumidor chama
+    bool pop(T& item){
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if(h == cachedTail){
+            cachedTail = tail.load(std::memory_order_acquire);
+            if(h == cachedTail){
+                return false;
+            }
+        }
+        item = items[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// Buffer triplo: o escritor preenche writeBuffer() e publica; o leitor pega sempre a
+// publicação mais recente com update() e a lê em readBuffer() pelo tempo que quiser.
+// Nenhum dos dois espera o outro: o escritor nunca toca o buffer em leitura, e
+// publicações que o leitor não chegou a ver são simplesmente sobrescritas. Os três
+// objetos são reaproveitados, então atribuições neles reusam a memória já alocada.
+template<typename T>
+class tripleBuffer{
+
+private:
+    static constexpr unsigned freshBit = 4;   // O buffer do meio ainda não foi lido
+    static constexpr unsigned indexMask = 3;
+
+    T slots[3];
+    alignas(cacheLine) std::atomic<unsigned> middle{2};
+    alignas(cacheLine) unsigned back = 1;    // Do escritor
+    alignas(cacheLine) unsigned front = 0;   // Do leitor
+
+public:
+    // Só o escritor chama
+    T& writeBuffer(){
+        return slots[back];
+    }
+
+    void publish(){
+        back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Só o leitor chama. Retorna true se trocou para uma publicação nova.
+    bool update(){
+        if((middle.load(std::memory_order_relaxed) & freshBit) == 0){
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& readBuffer() const{
+        return slots[front];
+    }
+};
+
+// Fila limitada de vários produtores e vários consumidores (MPMC, Vyukov). Cada célula
+// tem um número de sequência que diz se ela está livre para o produtor da volta atual
+// ou pronta para o consumidor; uma operação só disputa (por CAS) o índice do seu lado.
+// push e pop nunca bloqueiam: retornam false com a fila cheia ou vazia. Os itens são
+// movidos, então podem carregar memória própria (um std::vector, por exemplo).
+template<typename T, std::size_t Capacity>
+class mpmcQueue{
+
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacidade deve ser potencia de 2");
+
+private:
+    struct cell{
+        std::atomic<std::size_t> sequence;
+        T item;
+    };
+
+    cell cells[Capacity];
+    alignas(cacheLine) std::atomic<std::size_t> enqueuePos{0};
+    alignas(cacheLine) std::atomic<std::size_t> dequeuePos{0};
+
+public:
+    mpmcQueue(){
+        for(std::size_t i = 0; i < Capacity; ++i){
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmcQueue(const mpmcQueue&) = delete;
+    mpmcQueue& operator=(const mpmcQueue&) = delete;
+
+    // Qualquer thread. Em caso de falha 'item' não é tocado.
+    bool push(T&& item){
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for(;;){
+            cell& c = cells[pos & (Capacity - 1)];
+            std::size_t sequence = c.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+            if(diff == 0){
+                if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                    c.item = std::move(item);
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }else if(diff < 0){
+                return false;   // Cheia: a célula ainda guarda um item da volta anterior
+            }else{
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Qualquer thread
+    bool pop(T& item){
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for(;;){
+            cell& c = cells[pos & (Capacity - 1)];
+            std::size_t sequence = c.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos + 1);
+            if(diff == 0){
+                if(dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                    item = std::move(c.item);
+                    c.sequence.store(pos + Capacity, std::memory_order_release);
+                    return true;
+                }
+            }else if(diff < 0){
+                return false;   // Vazia
+            }else{
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+// Opções de linha de comando
+struct runOptions{
+    bool headless;   // Janela invisível + FBO, sem vsync, sem interação
+    int frames;      // Quadros renderizados no modo headless
+    int subsets;     // Subconjuntos da cena roteirizada do modo headless
+    const char* recordPath;   // Grava teclas e cliques neste arquivo (nullptr: não grava)
+    const char* replayPath;   // Reproduz teclas e cliques deste arquivo
+    bool hasSeed;
+    unsigned long long seed;  // Semente do gerador aleatório (--seed)
+    int workload;    // workloadShape da cena sintética (-1: 5 pontos uniformes por subconjunto)
+    int points;      // Média de pontos por subconjunto da cena sintética
+    bool bench3d;    // Mede os volumes 3D (AABB3, esfera, OBB3) e sai, sem janela
+    const char* scanPath;     // Nuvem 3D "x y z" do --bench3d e do --check-precision (nullptr: gera com --workload)
+    bool checkPrecision;      // Compara os volumes 3D em float e em double e sai
+    const char* loadPath;     // Subconjuntos 2D "x y" carregados em segundo plano (nullptr: nenhum)
+    int quantizeBits;         // --quantize: compara a nuvem 2D quantizada (16 ou 32 bits) com a em double e sai (0: não)
+    bool calibrate;           // Mede os custos da seleção automática nesta máquina antes de começar
+    double looseness;         // Maior razão área do volume / área do fecho da seleção automática (0: a do modelo)
+};
+
+// Preenche 'options' a partir de argv. Em erro (ou --help) imprime o uso e retorna false.
+bool parseOptions(int argc, char** argv, runOptions& options);
@@ -0,0 +1,81 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads persistente: as threads são criadas uma vez e esperam tarefas.
+class threadPool{
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void workerLoop();
+
+public:
+    explicit threadPool(unsigned int count = std::thread::hardware_concurrency());
+    ~threadPool();
+
+    threadPool(const threadPool&) = delete;
+    threadPool& operator=(const threadPool&) = delete;
+
+    unsigned int size() const;
+
+    // Enfileira uma tarefa; não espera ela terminar.
+    void submit(std::function<void()> task);
+
+    // Executa fn(k) para todo k em [0, count) e retorna quando todos terminarem.
+    // A thread que chama também trabalha, então pode ser usado de dentro de uma tarefa.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+};
+
+// Pool compartilhado pelo programa inteiro
+threadPool& defaultPool();
+
+// fn(k) para todo k em [0, count): com 'pool' via parallelFor, sem ele em série na
+// thread que chama. É o laço dos construtores "um volume por subconjunto".
+template<typename Fn>
+void forEachIndex(threadPool* pool, std::size_t count, Fn fn){
+    if(pool != nullptr){
+        pool->parallelFor(count, fn);
+    }else{
+        for(std::size_t k = 0; k < count; ++k){
+            fn(k);
+        }
+    }
+}
+
+// Bloco do triângulo superior (i < j) de uma matriz de pares n x n
+struct pairTile{
+    std::size_t i_begin;
+    std::size_t i_end;
+    std::size_t j_begin;
+    std::size_t j_end;
+};
+
+// Divide os pares {i < j} de n elementos em blocos tile x tile (apenas blocos com
+// i_begin <= j_begin), para que cada bloco toque poucos dados e caiba no cache.
+std::pmr::vector<pairTile> upperTriangleTiles(std::size_t n, std::size_t tile, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+// Chama fn(t, i, j) uma vez para cada par não ordenado i < j, em paralelo por bloco.
+// t é o índice do bloco, para que cada bloco escreva em sua própria saída.
+template<typename Fn>
+void forEachPairTiled(threadPool& pool, const std::pmr::vector<pairTile>& tiles, Fn fn){
+    pool.parallelFor(tiles.size(), [&](std::size_t t){
+        const pairTile& tile = tiles[t];
+        for(std::size_t i = tile.i_begin; i < tile.i_end; ++i){
+            std::size_t j = (tile.j_begin > i + 1) ? tile.j_begin : i + 1;
+            for(; j < tile.j_end; ++j){
+                fn(t, i, j);
+            }
+        }
+    });
+}
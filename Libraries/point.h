@@ -1,17 +1,4 @@
 #pragma once
-#include <cmath>
+#include "vecmath.h"
 
-struct ponto2D{
-
-    double x;
-    double y;
-
-    ponto2D operator+(const ponto2D& p) const;
-    ponto2D operator-(const ponto2D& p) const;
-    ponto2D operator*(const double& s) const;
-
-    ponto2D();
-    ponto2D(double x, double y);
-
-    double distance(const ponto2D& p);
-};
\ No newline at end of file
+using ponto2D = vector2<double>;
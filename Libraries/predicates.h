@@ -0,0 +1,25 @@
+#pragma once
+#include "point.h"
+
+// Predicados geométricos adaptativos (Shewchuk): um filtro rápido em ponto flutuante
+// resolve quase todos os casos, e a aritmética exata de expansões só roda quando o
+// sinal do determinante é ambíguo.
+
+struct predicateStats{
+    unsigned long long fast;  // Chamadas resolvidas pelo filtro
+    unsigned long long exact; // Chamadas que caíram na aritmética exata
+};
+
+// > 0 se c está à esquerda de ab, < 0 se à direita, 0 se a, b e c são colineares.
+// O sinal é sempre exato; a magnitude é apenas aproximada.
+double orient2d(const ponto2D& a, const ponto2D& b, const ponto2D& c);
+
+// Segmentos ab e cd se tocam (inclui extremidades encostadas e sobreposição colinear).
+bool segmentsIntersect(const ponto2D& a, const ponto2D& b, const ponto2D& c, const ponto2D& d);
+
+// Ponto de contato entre ab e cd. Retorna false se os segmentos não se tocam.
+// Em sobreposição colinear devolve uma extremidade contida no outro segmento.
+bool segmentIntersectionPoint(const ponto2D& a, const ponto2D& b, const ponto2D& c, const ponto2D& d, ponto2D& out);
+
+predicateStats getPredicateStats();
+void resetPredicateStats();
@@ -0,0 +1,63 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+// Medição de tempo por escopo. Com o profiler desligado, um PROFILE_SCOPE custa a
+// leitura de um bool; ligado, cada escopo grava sua duração em uma janela móvel
+// (para os percentis) e um evento para o trace no formato do Chrome (chrome://tracing).
+
+void setProfilingEnabled(bool enabled);
+bool profilingEnabled();
+
+// Grava um intervalo já medido (em nanossegundos do steady_clock)
+void profileRecord(const char* name, long long startNs, long long endNs);
+
+long long profileNow();
+
+class scopedTimer{
+
+private:
+    const char* name;
+    long long start;
+    bool active;
+
+public:
+    explicit scopedTimer(const char* name): name{name}, start{0}, active{profilingEnabled()} {
+        if(active){
+            start = profileNow();
+        }
+    }
+
+    ~scopedTimer(){
+        if(active){
+            profileRecord(name, start, profileNow());
+        }
+    }
+
+    scopedTimer(const scopedTimer&) = delete;
+    scopedTimer& operator=(const scopedTimer&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// O nome deve ser um literal: os escopos são agrupados pelo ponteiro da string
+#define PROFILE_SCOPE(name) scopedTimer PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+struct timerSummary{
+    const char* name;
+    std::size_t samples;  // Amostras na janela móvel
+    double p50;           // Milissegundos
+    double p95;
+    double p99;
+};
+
+// Percentis da janela móvel de cada escopo; escreve até 'capacity' e retorna quantos.
+std::size_t profileSummary(timerSummary* out, std::size_t capacity);
+
+// Resumo curto ("nome p50/p95" de cada escopo) para o título da janela, sem alocar
+void profileTitle(char* buffer, std::size_t size);
+
+// Escreve os eventos gravados como JSON do Chrome trace. Retorna false se falhar.
+bool writeChromeTrace(const char* path);
+
+void resetProfile();
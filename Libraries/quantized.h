@@ -0,0 +1,78 @@
+#pragma once
+#include "point.h"
+#include "volumes.h"
+#include "parallel.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Ponto da grade de quantização: coordenadas inteiras em unidades de 'step'
+struct latticePoint{
+    std::int64_t x;
+    std::int64_t y;
+};
+
+// Nuvem 2D quantizada em Structure of Arrays. Cada ponto é guardado como um inteiro
+// de I (int16_t ou int32_t) por eixo, relativo à origem do seu subconjunto, e vale
+// (origem + q) * step. O passo é uma potência de 2 comum à nuvem toda, então:
+//  - decodificar é exato em double e cada coordenada dista no máximo step / 2 da
+//    original;
+//  - pontos de subconjuntos diferentes estão na mesma grade, e os predicados inteiros
+//    abaixo são exatos entre quaisquer deles.
+// Em int16_t um ponto ocupa 4 bytes (16 em ponto2D), em int32_t 8 bytes.
+template<typename I>
+struct quantizedCloud2D{
+    double step = 1.0;
+    std::vector<I> x;
+    std::vector<I> y;
+    std::vector<std::int64_t> origin_x;   // Origem de cada subconjunto, em passos
+    std::vector<std::int64_t> origin_y;
+    std::vector<std::size_t> offsets{0};
+
+    std::size_t subsets() const;
+    std::size_t points() const;
+    std::size_t begin(std::size_t k) const;
+    std::size_t end(std::size_t k) const;
+
+    // Ponto i (do subconjunto k) na grade e no plano
+    latticePoint lattice(std::size_t k, std::size_t i) const;
+    ponto2D point(std::size_t k, std::size_t i) const;
+
+    // Memória ocupada pelos arrays (sem contar capacidade ociosa)
+    std::size_t bytes() const;
+};
+
+using quantized16 = quantizedCloud2D<std::int16_t>;
+using quantized32 = quantizedCloud2D<std::int32_t>;
+
+// Menor passo (potência de 2) em que todo subconjunto de 'cloud' cabe em 'bits' bits
+// por eixo em torno do seu centro. Também garante |coordenada| / passo < 2^52, para que
+// a grade inteira seja exata em double.
+double quantizationStep(const std::vector<std::vector<ponto2D>>& cloud, int bits);
+
+// Quantiza 'cloud' com o passo de quantizationStep(cloud, bits de I)
+template<typename I>
+void quantizeCloud(const std::vector<std::vector<ponto2D>>& cloud, quantizedCloud2D<I>& out);
+
+// Volumes conservadores construídos direto sobre os inteiros: contêm os pontos
+// ORIGINAIS, não só os quantizados (a AABB cresce meio passo, o raio meio passo * raiz de 2).
+// Os laços percorrem os arrays de I e são vetorizados.
+template<typename I>
+aabb2D quantizedAABB(const quantizedCloud2D<I>& cloud, std::size_t k);
+
+template<typename I>
+circle2D quantizedCircle(const quantizedCloud2D<I>& cloud, std::size_t k);
+
+template<typename I>
+void quantizedAABBs(const quantizedCloud2D<I>& cloud, std::vector<aabb2D>& out, threadPool* pool = nullptr);
+
+template<typename I>
+void quantizedCircles(const quantizedCloud2D<I>& cloud, std::vector<circle2D>& out, threadPool* pool = nullptr);
+
+// Predicados exatos na grade, em aritmética inteira de 128 bits (sem filtro nem
+// expansões): coordenadas de até 2^61 em módulo não transbordam.
+// Sinal de orient2d: > 0 se c está à esquerda de ab, < 0 à direita, 0 colineares.
+int orientLattice(const latticePoint& a, const latticePoint& b, const latticePoint& c);
+
+// Mesma semântica de segmentsIntersect (predicates.h): toques e sobreposições contam
+bool segmentsIntersectLattice(const latticePoint& a, const latticePoint& b, const latticePoint& c, const latticePoint& d);
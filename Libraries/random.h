@@ -0,0 +1,69 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// Gerador xoshiro256** (Blackman & Vigna): 32 bytes de estado, poucas instruções por
+// número e boa qualidade estatística. Satisfaz UniformRandomBitGenerator, então também
+// funciona com as distribuições de <random>.
+class xoshiro256ss{
+
+private:
+    std::uint64_t s[4];
+
+public:
+    using result_type = std::uint64_t;
+
+    explicit xoshiro256ss(std::uint64_t seed = 0);
+
+    // Estado expandido da semente com splitmix64 (nunca fica todo zero)
+    void seed(std::uint64_t seed);
+
+    static constexpr result_type min(){ return 0; }
+    static constexpr result_type max(){ return ~result_type(0); }
+
+    result_type operator()(){
+        const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+
+        return result;
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k){
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+// Define a semente da sessão. Os geradores por thread (threadRandom) são
+// resemeados na próxima vez que forem usados.
+void seedRandom(std::uint64_t seed);
+std::uint64_t randomSeed();
+
+// Gerador da thread atual, derivado de randomSeed() e da ordem em que a thread
+// o usou pela primeira vez (a thread principal, que semeia, é a 0). Sem trava.
+xoshiro256ss& threadRandom();
+
+// Fluxo independente 'stream' da semente 'seed': o mesmo par gera sempre a mesma
+// sequência, em qualquer thread. É o que a geração em paralelo deve usar para não
+// depender de qual thread processa qual parte.
+xoshiro256ss randomStream(std::uint64_t seed, std::uint64_t stream);
+
+// Real uniforme em [lo, hi) com os 53 bits altos do gerador. Ao contrário de
+// std::uniform_real_distribution, o resultado é o mesmo em qualquer biblioteca padrão.
+inline double randomUniform(xoshiro256ss& gen, double lo, double hi){
+    return lo + (hi - lo) * (double(gen() >> 11) * 0x1.0p-53);
+}
+
+// Normal padrão (Box-Muller), também independente da biblioteca padrão
+inline double randomGaussian(xoshiro256ss& gen){
+    double u = 1.0 - randomUniform(gen, 0.0, 1.0);   // (0, 1]: log(u) é finito
+    double v = randomUniform(gen, 0.0, 1.0);
+    return std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * v);
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "point.h"
+#include "../glad/include/glad/glad.h"
+#include "glm/gtc/matrix_transform.hpp"
+#include <cstddef>
+#include <vector>
+
+// Camadas: dentro de um quadro, uma camada é desenhada inteira antes da próxima.
+// Dentro da camada os desenhos são agrupados por programa e primitiva, mantendo a
+// ordem de envio (o que foi enviado depois fica por cima).
+enum renderLayer{
+    LAYER_AXES = 0,
+    LAYER_VOLUMES = 1,
+    LAYER_POINTS = 2
+};
+
+// Vértice intercalado: posição (location 0) e cor (location 1)
+struct colorVertex{
+    float x, y, z;
+    float r, g, b;
+};
+
+struct renderStats{
+    unsigned int glCalls;       // Chamadas GL feitas pelo renderer no quadro
+    unsigned int drawCalls;     // glDrawArrays / glMultiDrawArrays
+    unsigned int stateChanges;  // glUseProgram efetivamente emitidos
+    unsigned int skippedBinds;  // Trocas de estado evitadas pelo cache
+};
+
+// Camada de estado sobre o OpenGL. Os desenhos do quadro são enfileirados com
+// submit() e emitidos em flush(): os comandos são ordenados por (camada, programa,
+// primitiva), os vértices sobem em um único buffer já nessa ordem, e cada grupo de
+// primitivas independentes (pontos, linhas) vira um único glDrawArrays. A cor é um
+// atributo do vértice, então cores diferentes não quebram o grupo. A projeção vive
+// em um uniform buffer que só é atualizado quando muda.
+class renderer{
+
+private:
+    struct drawCommand{
+        int layer;
+        int program;
+        GLenum mode;
+        GLint first;
+        GLsizei count;
+    };
+
+    std::vector<unsigned int> programs;
+    std::vector<drawCommand> commands;
+    std::vector<colorVertex> vertices;  // Na ordem de envio
+    std::vector<colorVertex> sorted;    // Na ordem de desenho, enviada ao VBO
+    std::vector<GLint> firsts;
+    std::vector<GLsizei> counts;
+
+    unsigned int vao;
+    unsigned int vbo;
+    std::size_t vboCapacity;
+    unsigned int matricesUBO;
+
+    glm::mat4 projection;
+    bool hasProjection;
+    int boundProgram;
+
+    renderStats stats;
+
+    void useProgram(int program);
+
+public:
+    renderer();
+
+    // Cria VAO/VBO de streaming e o uniform buffer da projeção. Requer contexto GL.
+    void init();
+
+    // Registra um programa já vinculado; retorna o índice usado em submit().
+    int addProgram(unsigned int program);
+
+    // Atualiza o uniform buffer apenas se a matriz mudou
+    void setProjection(const glm::mat4& matrix);
+
+    // Enfileira 'count' vértices (x, y, z), todos com a mesma cor
+    void submit(int layer, GLenum mode, const float* xyz, std::size_t count, float red, float green, float blue, int program = 0);
+
+    // Enfileira 'count' vértices que já trazem a própria cor
+    void submit(int layer, GLenum mode, const colorVertex* data, std::size_t count, int program = 0);
+
+    // Emite todos os comandos enfileirados e esvazia a fila
+    void flush();
+
+    void beginFrame();
+    renderStats frameStats() const;
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Gravação de entrada: teclas e cliques com o instante (em segundos desde o início)
+// e a semente do gerador aleatório, para que uma sessão possa ser reproduzida
+// exatamente. Formato texto, uma linha por evento:
+//
+//   # BoundingVolume replay v1
+//   seed 12345
+//   key 0.532 82            (instante, código GLFW da tecla)
+//   click 1.200 -35.5 42.0  (instante, coordenadas de mundo)
+
+enum inputEventType{
+    EVENT_KEY = 0,
+    EVENT_CLICK = 1
+};
+
+struct inputEvent{
+    double time;
+    int type;
+    int key;      // EVENT_KEY
+    double x;     // EVENT_CLICK, em coordenadas de mundo
+    double y;
+};
+
+struct inputScript{
+    unsigned long long seed;
+    std::vector<inputEvent> events;   // Em ordem crescente de 'time'
+};
+
+bool loadInputScript(const char* path, inputScript& script);
+bool saveInputScript(const char* path, const inputScript& script);
+
+// Entrega os eventos de um roteiro conforme o relógio avança
+class inputPlayer{
+
+private:
+    const inputScript* script;
+    std::size_t next;
+
+public:
+    explicit inputPlayer(const inputScript& script);
+
+    // Chama handler para cada evento com time <= now ainda não entregue; retorna quantos
+    std::size_t dispatchUntil(double now, const std::function<void(const inputEvent&)>& handler);
+
+    bool finished() const;
+    double lastEventTime() const;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include "point.h"
+#include "volumes.h"
+#include "parallel.h"
+#include <cstddef>
+#include <vector>
+
+// Modelo de custo da seleção automática de volumes
+struct volumeCostModel{
+    double testCost[VOLUME_KINDS];  // Custo relativo de um teste de sobreposição entre dois volumes do tipo
+    double maxLooseness;            // Maior razão área do volume / área do fecho aceitável
+};
+
+// Custos gravados de calibrateCostModel sobre a carga "--workload mixed" (400
+// subconjuntos de 50 pontos, -O3 -march=native, x86-64), normalizados pela AABB; --calibrate os
+// mede de novo na máquina atual. maxLooseness = 1.6 deixa a AABB vencer em boa parte
+// das formas compactas e ainda troca os conjuntos alongados pela cápsula ou OBB
+// (--looseness muda). A elipse é cara por causa da bisseção da distância ponto-elipse.
+volumeCostModel defaultCostModel();
+
+// Mede o custo por par de intersectVolumes com os candidatos de até 400 subconjuntos
+// de 'cloud', um tipo por vez (melhor de 3 execuções em uma thread), normalizado pela AABB
+volumeCostModel calibrateCostModel(const std::vector<std::vector<ponto2D>>& cloud, double maxLooseness);
+
+// Candidatos de um subconjunto e a escolha
+struct volumeChoice{
+    taggedVolume candidates[VOLUME_KINDS];
+    double looseness[VOLUME_KINDS];   // Área do candidato / área do fecho convexo
+    int chosen;
+};
+
+// Constrói os cinco candidatos (AABB, círculo pelo centróide, OBB pelo eixo principal,
+// cápsula e elipse) e escolhe o de menor custo de teste entre os adequados
+// (looseness <= maxLooseness). Se nenhum for adequado, fica o mais justo.
+volumeChoice chooseVolume(const std::vector<ponto2D>& points, const volumeCostModel& model);
+
+// Um volume por subconjunto em 'volumes' (em paralelo com 'pool'). Se 'histogram' não
+// for nulo, recebe quantos subconjuntos ficaram com cada tipo.
+void selectVolumes(const std::vector<std::vector<ponto2D>>& cloud, std::vector<taggedVolume>& volumes, const volumeCostModel& model,
+                   threadPool* pool = nullptr, std::size_t histogram[VOLUME_KINDS] = nullptr);
@@ -0,0 +1,80 @@
+#pragma once
+#include "parallel.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+// Tempo de uma tarefa na última execução do grafo (nanossegundos do steady_clock)
+struct taskTiming{
+    const char* name;
+    long long startNs;
+    long long endNs;
+    std::size_t thread;   // Hash do id da thread que executou
+};
+
+// Grafo de tarefas sobre o threadPool. Cada tarefa declara de quais depende; run()
+// executa as independentes em paralelo e libera cada uma assim que a última de suas
+// dependências termina. A thread que termina uma tarefa segue direto com uma das que
+// ficaram prontas e entrega as outras ao pool, e a thread que chamou run() executa a
+// primeira tarefa sem dependências em vez de só esperar. Qual thread roda cada tarefa
+// não é garantido: o que uma tarefa sorteia deve vir de um gerador passado a ela, não
+// de threadRandom().
+//
+// Toda tarefa é cronometrada (timing()) e, com o profiler ligado, gravada com o seu
+// nome: aparece nos percentis do título e no trace, uma linha por thread.
+//
+// As tarefas podem usar parallelFor no mesmo pool. run() espera o grafo inteiro, então
+// não deve ser chamado de dentro de uma tarefa do pool. clear() mantém a memória das
+// tarefas, então montar de novo um grafo do mesmo tamanho não aloca.
+class taskGraph{
+
+private:
+    struct task{
+        const char* name;
+        std::function<void()> fn;
+        std::vector<std::size_t> dependents;
+        int dependencies;
+        std::atomic<int> pending{0};
+        taskTiming timing;
+    };
+
+    std::deque<task> tasks;
+    std::size_t count = 0;
+    std::atomic<std::size_t> remaining{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;   // Protegido por 'mutex': a última tarefa terminou
+    threadPool* pool = nullptr;
+    long long lastRunNs = 0;
+
+    void execute(std::size_t index);
+
+public:
+    taskGraph() = default;
+    taskGraph(const taskGraph&) = delete;
+    taskGraph& operator=(const taskGraph&) = delete;
+
+    // Acrescenta uma tarefa e retorna o seu índice. As dependências são índices de
+    // tarefas já adicionadas, então o grafo nunca tem ciclos. O nome deve ser um
+    // literal, como em PROFILE_SCOPE.
+    std::size_t add(const char* name, std::function<void()> fn, std::initializer_list<std::size_t> dependencies = {});
+
+    // A tarefa 'index' passa a esperar também a tarefa 'on' (on < index)
+    void depend(std::size_t index, std::size_t on);
+
+    void clear();
+    std::size_t size() const;
+
+    // Executa todas as tarefas respeitando as dependências e retorna quando todas terminarem
+    void run(threadPool& pool);
+
+    const taskTiming& timing(std::size_t index) const;
+
+    // Duração total da última execução (do início de run() ao fim da última tarefa)
+    double lastRunMs() const;
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include "vectors.h"
+#include <cstddef>
+
+// n vetores 3D em SoA (um array por eixo), sem posse da memória
+struct vec3Span{
+    double* x;
+    double* y;
+    double* z;
+    std::size_t n;
+};
+
+// Versão somente leitura; todo vec3Span se converte nela
+struct vec3View{
+    const double* x;
+    const double* y;
+    const double* z;
+    std::size_t n;
+
+    vec3View(const double* x, const double* y, const double* z, std::size_t n): x{x}, y{y}, z{z}, n{n} {}
+    vec3View(const vec3Span& s): x{s.x}, y{s.y}, z{s.z}, n{s.n} {}
+};
+
+// Núcleos em lote sobre vec3 em SoA. Em x86 cada um tem versões AVX-512, AVX2 e
+// padrão (target_clones), e a melhor para a CPU é escolhida uma vez, ao carregar o
+// programa; assim o mesmo binário aproveita máquinas mais novas que a do build.
+// A saída pode ser exatamente a entrada 'a' (os mesmos três ponteiros: operação no
+// lugar); fora isso, saída e entradas não se sobrepõem. Todas as vistas têm o mesmo n.
+
+void batchDot(const vec3View& a, const vec3View& b, double* out);        // out[i] = a_i · b_i
+void batchCross(const vec3View& a, const vec3View& b, const vec3Span& out);  // out_i = a_i x b_i
+void batchNorm(const vec3View& a, double* out);                          // out[i] = |a_i|
+void batchNormalize(const vec3View& a, const vec3Span& out);             // out_i = a_i / |a_i| (a_i não nulo)
+
+// out_i = projeção de a_i em 'onto' (não nulo)
+void batchProjection(const vec3View& a, const vec3& onto, const vec3Span& out);
+
+// Reflexão pelo plano que passa pela origem com normal 'normal' (não nula):
+// out_i = a_i - 2 (a_i · n) n / (n · n). reflect(v, 'z') é o caso normal = (0, 0, 1).
+void batchReflect(const vec3View& a, const vec3& normal, const vec3Span& out);
+
+// Transformação afim: out_i = (rows[0] · a_i, rows[1] · a_i, rows[2] · a_i) + translation
+void batchTransform(const vec3View& a, const vec3 rows[3], const vec3& translation, const vec3Span& out);
@@ -0,0 +1,215 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// Vetores 2D, 3D e 4D por valor, só no cabeçalho: tudo é inline (boa parte constexpr)
+// e os tipos são trivialmente copiáveis, então o compilador os mantém em registradores
+// e vetoriza os laços que os usam. ponto2D e vec3 são os casos em double.
+
+template<typename T>
+struct vector2{
+    T x{};
+    T y{};
+
+    constexpr vector2() = default;
+    constexpr vector2(T x, T y): x{x}, y{y} {}
+
+    constexpr vector2 operator+(const vector2& v) const{ return vector2(x + v.x, y + v.y); }
+    constexpr vector2 operator-(const vector2& v) const{ return vector2(x - v.x, y - v.y); }
+    constexpr vector2 operator-() const{ return vector2(-x, -y); }
+    constexpr vector2 operator*(T s) const{ return vector2(x * s, y * s); }
+    constexpr vector2 operator/(T s) const{ return vector2(x / s, y / s); }
+    friend constexpr vector2 operator*(T s, const vector2& v){ return v * s; }
+
+    constexpr vector2& operator+=(const vector2& v){ x += v.x; y += v.y; return *this; }
+    constexpr vector2& operator-=(const vector2& v){ x -= v.x; y -= v.y; return *this; }
+    constexpr vector2& operator*=(T s){ x *= s; y *= s; return *this; }
+
+    constexpr bool operator==(const vector2& v) const{ return x == v.x && y == v.y; }
+    constexpr bool operator!=(const vector2& v) const{ return !(*this == v); }
+};
+
+template<typename T>
+struct vector3{
+    T x{};
+    T y{};
+    T z{};
+
+    constexpr vector3() = default;
+    constexpr vector3(T x, T y, T z): x{x}, y{y}, z{z} {}
+
+    constexpr vector3 operator+(const vector3& v) const{ return vector3(x + v.x, y + v.y, z + v.z); }
+    constexpr vector3 operator-(const vector3& v) const{ return vector3(x - v.x, y - v.y, z - v.z); }
+    constexpr vector3 operator-() const{ return vector3(-x, -y, -z); }
+    constexpr vector3 operator*(T s) const{ return vector3(x * s, y * s, z * s); }
+    constexpr vector3 operator/(T s) const{ return vector3(x / s, y / s, z / s); }
+    friend constexpr vector3 operator*(T s, const vector3& v){ return v * s; }
+
+    constexpr vector3& operator+=(const vector3& v){ x += v.x; y += v.y; z += v.z; return *this; }
+    constexpr vector3& operator-=(const vector3& v){ x -= v.x; y -= v.y; z -= v.z; return *this; }
+    constexpr vector3& operator*=(T s){ x *= s; y *= s; z *= s; return *this; }
+
+    constexpr bool operator==(const vector3& v) const{ return x == v.x && y == v.y && z == v.z; }
+    constexpr bool operator!=(const vector3& v) const{ return !(*this == v); }
+
+    // Interface antiga de vec3
+    constexpr T get_x() const{ return x; }
+    constexpr T get_y() const{ return y; }
+    constexpr T get_z() const{ return z; }
+
+    // Coordenada i (0: x, 1: y, 2: z), para laços sobre os eixos
+    constexpr T component(int i) const{ return i == 0 ? x : (i == 1 ? y : z); }
+    T norma() const{ return std::sqrt(dot(*this)); }
+
+    constexpr vector3 inverse() const{ return -*this; }
+    constexpr T dot(const vector3& v) const{ return x * v.x + y * v.y + z * v.z; }
+
+    // Cálculo via determinante
+    constexpr vector3 cross(const vector3& v) const{
+        return vector3(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x);
+    }
+
+    // Projeção do vetor atual (this) em v
+    constexpr vector3 projection(const vector3& v) const{ return v * (dot(v) / v.dot(v)); }
+
+    void normalize(){ *this = *this * (T(1) / norma()); }
+};
+
+template<typename T>
+struct vector4{
+    T x{};
+    T y{};
+    T z{};
+    T w{};
+
+    constexpr vector4() = default;
+    constexpr vector4(T x, T y, T z, T w): x{x}, y{y}, z{z}, w{w} {}
+    constexpr vector4(const vector3<T>& v, T w): x{v.x}, y{v.y}, z{v.z}, w{w} {}
+
+    constexpr vector4 operator+(const vector4& v) const{ return vector4(x + v.x, y + v.y, z + v.z, w + v.w); }
+    constexpr vector4 operator-(const vector4& v) const{ return vector4(x - v.x, y - v.y, z - v.z, w - v.w); }
+    constexpr vector4 operator-() const{ return vector4(-x, -y, -z, -w); }
+    constexpr vector4 operator*(T s) const{ return vector4(x * s, y * s, z * s, w * s); }
+    constexpr vector4 operator/(T s) const{ return vector4(x / s, y / s, z / s, w / s); }
+    friend constexpr vector4 operator*(T s, const vector4& v){ return v * s; }
+
+    constexpr vector4& operator+=(const vector4& v){ x += v.x; y += v.y; z += v.z; w += v.w; return *this; }
+    constexpr vector4& operator-=(const vector4& v){ x -= v.x; y -= v.y; z -= v.z; w -= v.w; return *this; }
+    constexpr vector4& operator*=(T s){ x *= s; y *= s; z *= s; w *= s; return *this; }
+
+    constexpr bool operator==(const vector4& v) const{ return x == v.x && y == v.y && z == v.z && w == v.w; }
+    constexpr bool operator!=(const vector4& v) const{ return !(*this == v); }
+
+    constexpr vector3<T> xyz() const{ return vector3<T>(x, y, z); }
+};
+
+using vec2f = vector2<float>;
+using vec2d = vector2<double>;
+using vec3f = vector3<float>;
+using vec3d = vector3<double>;
+using vec4f = vector4<float>;
+using vec4d = vector4<double>;
+
+static_assert(std::is_trivially_copyable<vec2d>::value && std::is_trivially_copyable<vec3d>::value &&
+              std::is_trivially_copyable<vec4d>::value, "vetores devem ser copiados como bytes");
+static_assert(sizeof(vec3d) == 3 * sizeof(double), "sem preenchimento entre as coordenadas");
+
+// Produto escalar, comprimentos e distâncias. As versões ao quadrado evitam a raiz
+// e devem ser preferidas em comparações (d² <= r²).
+template<typename T> constexpr T dot(const vector2<T>& a, const vector2<T>& b){ return a.x * b.x + a.y * b.y; }
+template<typename T> constexpr T dot(const vector3<T>& a, const vector3<T>& b){ return a.x * b.x + a.y * b.y + a.z * b.z; }
+template<typename T> constexpr T dot(const vector4<T>& a, const vector4<T>& b){ return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+// Componente z do produto vetorial em 2D (a.x * b.y - a.y * b.x)
+template<typename T> constexpr T cross(const vector2<T>& a, const vector2<T>& b){ return a.x * b.y - a.y * b.x; }
+template<typename T> constexpr vector3<T> cross(const vector3<T>& a, const vector3<T>& b){ return a.cross(b); }
+
+template<typename V> constexpr auto lengthSquared(const V& v){ return dot(v, v); }
+template<typename V> constexpr auto distanceSquared(const V& a, const V& b){ return lengthSquared(a - b); }
+template<typename V> auto length(const V& v){ return std::sqrt(lengthSquared(v)); }
+template<typename V> auto distance(const V& a, const V& b){ return std::sqrt(distanceSquared(a, b)); }
+
+// Versor de v (v não nulo)
+template<typename V> V normalized(const V& v){ return v * (1 / length(v)); }
+
+static_assert(dot(vec3d(1, 2, 3), vec3d(4, 5, 6)) == 32, "dot deve ser constexpr");
+
+template<typename T> constexpr vector2<T> minimum(const vector2<T>& a, const vector2<T>& b){
+    return vector2<T>(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y);
+}
+template<typename T> constexpr vector2<T> maximum(const vector2<T>& a, const vector2<T>& b){
+    return vector2<T>(a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y);
+}
+template<typename T> constexpr vector3<T> minimum(const vector3<T>& a, const vector3<T>& b){
+    return vector3<T>(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z);
+}
+template<typename T> constexpr vector3<T> maximum(const vector3<T>& a, const vector3<T>& b){
+    return vector3<T>(a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z);
+}
+
+// Operações em lote sobre coordenadas em SoA (um array por eixo, 'n' elementos), para
+// qualquer T. Cada iteração é independente, então os laços são vetorizados com -O3 e as
+// flags de quem inclui. vecbatch.h tem os núcleos de vec3 em double com uma versão por
+// conjunto de instruções escolhida ao carregar o programa.
+
+// out[i] = |p_i - q|²
+template<typename T>
+void batchDistanceSquared(const T* __restrict x, const T* __restrict y, std::size_t n, vector2<T> q, T* __restrict out){
+    for(std::size_t i = 0; i < n; ++i){
+        T dx = x[i] - q.x, dy = y[i] - q.y;
+        out[i] = dx * dx + dy * dy;
+    }
+}
+
+template<typename T>
+void batchDistanceSquared(const T* __restrict x, const T* __restrict y, const T* __restrict z, std::size_t n, vector3<T> q, T* __restrict out){
+    for(std::size_t i = 0; i < n; ++i){
+        T dx = x[i] - q.x, dy = y[i] - q.y, dz = z[i] - q.z;
+        out[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+// out[i] = p_i · axis (projeção em um eixo)
+template<typename T>
+void batchDotAxis(const T* __restrict x, const T* __restrict y, std::size_t n, vector2<T> axis, T* __restrict out){
+    for(std::size_t i = 0; i < n; ++i){
+        out[i] = x[i] * axis.x + y[i] * axis.y;
+    }
+}
+
+template<typename T>
+void batchDotAxis(const T* __restrict x, const T* __restrict y, const T* __restrict z, std::size_t n, vector3<T> axis, T* __restrict out){
+    for(std::size_t i = 0; i < n; ++i){
+        out[i] = x[i] * axis.x + y[i] * axis.y + z[i] * axis.z;
+    }
+}
+
+// p_i += t (translada todos os pontos)
+template<typename T>
+void batchTranslate(T* __restrict x, T* __restrict y, std::size_t n, vector2<T> t){
+    for(std::size_t i = 0; i < n; ++i){
+        x[i] += t.x;
+        y[i] += t.y;
+    }
+}
+
+template<typename T>
+void batchTranslate(T* __restrict x, T* __restrict y, T* __restrict z, std::size_t n, vector3<T> t){
+    for(std::size_t i = 0; i < n; ++i){
+        x[i] += t.x;
+        y[i] += t.y;
+        z[i] += t.z;
+    }
+}
+
+// Normaliza os vetores (não nulos) no lugar
+template<typename T>
+void batchNormalizeInPlace(T* __restrict x, T* __restrict y, T* __restrict z, std::size_t n){
+    for(std::size_t i = 0; i < n; ++i){
+        T inv = T(1) / std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        x[i] *= inv;
+        y[i] *= inv;
+        z[i] *= inv;
+    }
+}
@@ -1,38 +1,30 @@
 #pragma once
 
+#include "vecmath.h"
 #include <iostream>
-#include <math.h>
-#include <cmath>
 
-
-class vec3{
-
-private:
-    double x;
-    double y;
-    double z;
-
-public:
-
-    vec3(double x, double y, double z);
-
-    double get_x() const;
-    double get_y() const;
-    double get_z() const;
-    double norma() const;
-
-    vec3 operator+(const vec3& v) const;
-    vec3 operator-(const vec3& v) const;
-    vec3 operator*(const double& s) const;
-
-    vec3 inverse() const;
-    double dot(const vec3& v) const;
-    vec3 cross(const vec3& v) const;
-
-    vec3 projection(const vec3& v) const; // projeção do vetor em v
-    vec3 reflect(const char& c) const;
-
-    void normalize();
-};
-
-std::ostream& operator<<(std::ostream& os, const vec3& v);
\ No newline at end of file
+using vec3 = vector3<double>;
+
+/* Reflexão relativa à coordenada z == Reflexão relativa ao plano xy
+   --> Preserva as coordenadas xy e inverte z.
+
+   |1 0 0 |   |x|    |x |
+   |0 1 0 | . |y| =  |y |   MATRIZ DE TRANSFORMAÇÃO -> reflect_z
+   |0 0 -1|   |z|    |-z|
+*/
+inline vec3 reflect(const vec3& v, char c){
+    if(c == 'z'){
+        return vec3(v.x, v.y, -v.z);
+    }else if(c == 'x'){
+        return vec3(-v.x, v.y, v.z);
+    }else if(c == 'y'){
+        return vec3(v.x, -v.y, v.z);
+    }else{
+        std::cout << "Reflexão inválida" << std::endl;
+        return vec3(0.0, 0.0, 0.0);
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, const vec3& v){
+    return os << "vec3(" << v.x << ", " << v.y << ", " << v.z << ")";
+}
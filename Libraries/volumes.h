@@ -0,0 +1,208 @@
+#pragma once
+#include "point.h"
+#include <vector>
+#include <utility>
+#include <tuple>
+#include <cstddef>
+#include <memory_resource>
+
+// AABB, círculo e OBB são templates na precisão T das coordenadas, double ou float,
+// como os volumes 3D (ver volumes3d.h). Em float (u = 2^-24 ~ 6e-8):
+//  - a AABB tem as faces afastadas um ulp, então contém também os pontos em double
+//    que foram arredondados para float (em double ela é exata);
+//  - círculo e OBB somam o centróide em double, projetam relativo a ele e recebem uma
+//    folga relativa de 8e-6 (1e-9 em double) que cresce com |c|: contêm os pontos
+//    guardados e os originais e diferem dos de double em poucos 1e-5 de |c|;
+//  - logo, pertinência e sobreposição só discordam de double para pontos ou volumes a
+//    menos de ~4e-5 * |c| da borda, e em float há pares a mais, nunca a menos.
+
+// Caixa alinhada aos eixos (AABB)
+template<typename T>
+struct aabb2{
+    T min_x;
+    T min_y;
+    T max_x;
+    T max_y;
+
+    // 0: Inferior Esquerdo, 1: Inferior Direito, 2: Superior Esquerdo, 3: Superior Direito
+    vector2<T> corner(int i) const;
+};
+
+// Círculo: (centro, raio)
+template<typename T>
+using circle2 = std::pair<vector2<T>, T>;
+
+// Caixa orientada: (centro, meias dimensões, eixo U, eixo V)
+template<typename T>
+using obb2 = std::tuple<vector2<T>, vector2<T>, vector2<T>, vector2<T>>;
+
+using aabb2D = aabb2<double>;
+using aabb2f = aabb2<float>;
+using circle2D = circle2<double>;
+using circle2f = circle2<float>;
+using obb2D = obb2<double>;
+using obb2f = obb2<float>;
+
+// Média dos pontos de um subconjunto não vazio (centro do círculo da tecla C)
+ponto2D calculateCentroid(const std::vector<ponto2D>& sub);
+
+// Volumes de um subconjunto (construtores das teclas A, C e O). O círculo é centrado
+// no centróide; a OBB usa o eixo unitário U dado e V = U girado 90 graus. Um
+// subconjunto vazio dá um volume degenerado na origem.
+template<typename T>
+aabb2<T> computeAABB2(const std::vector<vector2<T>>& points);
+template<typename T>
+circle2<T> computeCircle2(const std::vector<vector2<T>>& points);
+template<typename T>
+obb2<T> computeOBB2(const std::vector<vector2<T>>& points, const vector2<T>& U);
+
+// Inclusive a borda
+template<typename T> bool pointInAABB2(const aabb2<T>& box, const vector2<T>& p);
+template<typename T> bool pointInCircle2(const circle2<T>& circle, const vector2<T>& p);
+template<typename T> bool pointInOBB2(const obb2<T>& box, const vector2<T>& p);
+
+// Inclusive encostados. As OBB usam os 4 eixos separadores (eixos de a e de b).
+template<typename T> bool overlapAABB2(const aabb2<T>& a, const aabb2<T>& b);
+template<typename T> bool overlapCircles2(const circle2<T>& a, const circle2<T>& b);
+template<typename T> bool overlapOBB2(const obb2<T>& a, const obb2<T>& b);
+
+// Teste de intervalos sem desvios. Se as caixas se sobrepõem (inclusive encostadas),
+// retorna true e escreve em 'overlap' o retângulo de interseção.
+bool overlapAABB(const aabb2D& a, const aabb2D& b, aabb2D& overlap);
+
+// Pontos onde as bordas de a e b se cruzam: são os cantos de 'overlap' que estão
+// sobre uma aresta de cada caixa. Retorna quantos foram escritos em out (0 a 4).
+// Zero com sobreposição significa que uma caixa contém a outra.
+int aabbCrossings(const aabb2D& a, const aabb2D& b, const aabb2D& overlap, ponto2D out[4]);
+
+// Caixas em Structure of Arrays, para testar uma caixa contra muitas de uma vez.
+struct aabbSoA{
+    std::pmr::vector<double> min_x;
+    std::pmr::vector<double> min_y;
+    std::pmr::vector<double> max_x;
+    std::pmr::vector<double> max_y;
+
+    explicit aabbSoA(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    void assign(const std::vector<aabb2D>& boxes);
+    std::size_t size() const;
+};
+
+// mask[k - first] = box sobrepõe boxes[k], para k em [first, last). O laço não tem
+// desvios e é vetorizado pelo compilador.
+void overlapAABBBatch(const aabb2D& box, const aabbSoA& boxes, std::size_t first, std::size_t last, unsigned char* mask);
+
+// k-DOP: interseção de D faixas [lo, hi] ao longo de direções fixas, uniformemente
+// espaçadas em [0, pi) (o eixo k faz ângulo k * pi / D com o eixo x). D = 4 é o 8-DOP
+// (eixos e diagonais), D = 8 o 16-DOP. D = 2 seria a própria AABB.
+template<int D>
+struct kdop2D{
+    double lo[D];
+    double hi[D];
+};
+
+using dop8 = kdop2D<4>;
+using dop16 = kdop2D<8>;
+
+// Direção unitária do eixo k de um k-DOP com D eixos
+template<int D>
+ponto2D kdopAxis(int k);
+
+// Projeções mínima e máxima dos pontos em cada eixo. O laço interno tem D fixo e
+// vira min/max vetorial.
+template<int D>
+kdop2D<D> computeKDOP(const std::vector<ponto2D>& points);
+
+// Só comparações de intervalos, sem desvios (inclusive encostados)
+template<int D>
+bool overlapKDOP(const kdop2D<D>& a, const kdop2D<D>& b);
+
+template<int D>
+bool pointInKDOP(const kdop2D<D>& dop, const ponto2D& p);
+
+// Vértices do polígono em sentido anti-horário (até 2D); retorna quantos. Faces de
+// comprimento zero repetem vértices, que não são removidos.
+template<int D>
+int kdopVertices(const kdop2D<D>& dop, ponto2D out[2 * D]);
+
+// Cápsula: todos os pontos a até 'radius' do segmento ab
+struct capsule2D{
+    ponto2D a;
+    ponto2D b;
+    double radius;
+};
+
+// Elipse: centro, semi-eixos ao longo de U e de V = U girado 90 graus
+struct ellipse2D{
+    ponto2D center;
+    double semi_u;
+    double semi_v;
+    ponto2D U;
+};
+
+// Cápsula sobre o eixo principal (PCA) do conjunto: o raio cobre a espessura na
+// direção perpendicular e as pontas do segmento recuam o máximo que as semicircunferências permitem.
+capsule2D fitCapsule(const std::vector<ponto2D>& points);
+
+// Elipse de área mínima que contém os pontos (algoritmo de Khachiyan sobre os
+// vértices do fecho convexo), parando quando o passo fica abaixo de 'tolerance'.
+// No fim a elipse é ampliada o necessário para conter todos os pontos de fato.
+ellipse2D fitEllipse(const std::vector<ponto2D>& points, double tolerance = 1e-4, int maxIterations = 500);
+
+bool pointInCapsule(const capsule2D& capsule, const ponto2D& p);
+bool pointInEllipse(const ellipse2D& ellipse, const ponto2D& p);
+
+// Pontos mais próximos entre os segmentos p1q1 e p2q2 (Ericson, Real-Time Collision Detection 5.1.9)
+void closestSegmentPoints(const ponto2D& p1, const ponto2D& q1, const ponto2D& p2, const ponto2D& q2, ponto2D& c1, ponto2D& c2);
+
+// Distância entre os eixos <= soma dos raios
+bool overlapCapsules(const capsule2D& a, const capsule2D& b);
+
+// Exato a menos do arredondamento: a elipse a é levada ao espaço em que b é o círculo
+// unitário e comparada com a origem pela distância ponto-elipse de Eberly. 'point'
+// recebe o ponto de a mais fundo em b e 'distance' a distância dele ao centro de b,
+// na métrica de b (<= 1 quando se sobrepõem).
+bool overlapEllipses(const ellipse2D& a, const ellipse2D& b, ponto2D& point, double& distance);
+
+// Tipo de um volume guardado em taggedVolume
+enum volumeKind{
+    VOLUME_AABB = 0,
+    VOLUME_CIRCLE = 1,
+    VOLUME_OBB = 2,
+    VOLUME_CAPSULE = 3,
+    VOLUME_ELLIPSE = 4,
+    VOLUME_KINDS = 5
+};
+
+// Qualquer volume em um único layout, para arrays com tipos misturados:
+//   AABB/OBB: e0, e1 = meias dimensões ao longo de U e V (AABB: U = (1, 0))
+//   Círculo:  e0 = e1 = raio
+//   Cápsula:  e0 = meio comprimento do segmento (ao longo de U), e1 = raio
+//   Elipse:   e0, e1 = semi-eixos ao longo de U e V
+struct taggedVolume{
+    ponto2D center;
+    ponto2D U;
+    double e0;
+    double e1;
+    int kind;
+};
+
+taggedVolume makeVolume(const aabb2D& box);
+taggedVolume makeVolume(const circle2D& circle);
+taggedVolume makeVolume(const obb2D& box);
+taggedVolume makeVolume(const capsule2D& capsule);
+taggedVolume makeVolume(const ellipse2D& ellipse);
+
+// Conversões de volta, válidas apenas para o 'kind' correspondente
+aabb2D volumeAABB(const taggedVolume& v);
+circle2D volumeCircle(const taggedVolume& v);
+obb2D volumeOBB(const taggedVolume& v);
+capsule2D volumeCapsule(const taggedVolume& v);
+ellipse2D volumeEllipse(const taggedVolume& v);
+
+const char* volumeKindName(int kind);
+double volumeArea(const taggedVolume& v);
+bool pointInVolume(const taggedVolume& v, const ponto2D& p);
+
+// Ponto do volume mais distante na direção d (função suporte, usada pelo GJK)
+ponto2D volumeSupport(const taggedVolume& v, const ponto2D& d);
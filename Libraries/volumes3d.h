@@ -0,0 +1,147 @@
+#pragma once
+#include "vectors.h"
+#include "parallel.h"
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+// Nuvem 3D em Structure of Arrays: as coordenadas de todos os subconjuntos ficam
+// contíguas e o subconjunto k ocupa os índices [offsets[k], offsets[k + 1]).
+// Os laços dos construtores percorrem x, y e z separadamente e são vetorizados.
+//
+// T é double ou float. Em float a nuvem ocupa metade da memória e cada registrador
+// SIMD leva o dobro de coordenadas. Precisão (u = 2^-24 ~ 6e-8 em float):
+//  - as coordenadas guardadas diferem das originais em até u * |c|;
+//  - a AABB3 em float tem as faces afastadas um ulp, então contém também os pontos
+//    originais (em double ela é exata);
+//  - esfera e OBB3 acumulam centróide e covariância e resolvem os casos exatos em
+//    double, e recebem uma folga relativa de 8e-6 (1e-9 em double) que cresce com |c|:
+//    contêm todos os pontos guardados e os originais e diferem das de double em poucos
+//    1e-5 da magnitude |c| das coordenadas (longe da origem elas só crescem);
+//  - logo, pertinência e sobreposição só discordam de double para pontos ou volumes a
+//    menos de ~4e-5 * |c| da borda, e em float há pares a mais, nunca a menos.
+//    --check-precision mede isso numa nuvem gerada ou lida.
+template<typename T>
+struct cloud3{
+    std::vector<T> x;
+    std::vector<T> y;
+    std::vector<T> z;
+    std::vector<std::size_t> offsets{0};
+
+    void clear();
+    void addSubset(const std::vector<vector3<T>>& points);
+
+    std::size_t subsets() const;
+    std::size_t points() const;
+    std::size_t begin(std::size_t k) const;
+    std::size_t end(std::size_t k) const;
+    vector3<T> point(std::size_t i) const;
+};
+
+using cloud3SoA = cloud3<double>;
+using cloud3f = cloud3<float>;
+
+// Copia 'from' para 'to' na precisão de 'to' (mesmos subconjuntos)
+template<typename T, typename U>
+void convertCloud(const cloud3<U>& from, cloud3<T>& to);
+
+// Lê um arquivo texto "x y z" por linha; uma linha em branco começa um novo
+// subconjunto e linhas iniciadas por '#' são ignoradas.
+bool loadCloud3(const char* path, cloud3SoA& cloud);
+
+template<typename T>
+struct aabb3{
+    T min_x;
+    T min_y;
+    T min_z;
+    T max_x;
+    T max_y;
+    T max_z;
+};
+
+// Esfera: (centro, raio), como circle2D
+template<typename T>
+using sphere3 = std::pair<vector3<T>, T>;
+
+// Caixa orientada: centro, meias dimensões e os três eixos (ortonormais)
+template<typename T>
+struct obb3{
+    vector3<T> center;
+    vector3<T> half_sizes;
+    vector3<T> axes[3];
+};
+
+using aabb3D = aabb3<double>;
+using aabb3f = aabb3<float>;
+using sphere3D = sphere3<double>;
+using sphere3f = sphere3<float>;
+using obb3D = obb3<double>;
+using obb3f = obb3<float>;
+
+// Construtores de esfera
+enum sphereMethod{
+    SPHERE_CENTROID = 0,   // Centróide + ponto mais distante (como calculateCircle)
+    SPHERE_RITTER = 1,     // Ritter: dois pontos afastados e uma passada de crescimento
+    SPHERE_EPOS6 = 2,      // EPOS (Larsson): esfera exata dos extremos em 3, 7 ou 13
+    SPHERE_EPOS14 = 3,     // direções fixas e depois a passada de crescimento de Ritter
+    SPHERE_EPOS26 = 4,
+    SPHERE_WELZL = 5,      // Menor esfera exata (Welzl, tempo linear esperado)
+    SPHERE_METHODS = 6
+};
+
+const char* sphereMethodName(int method);
+
+// Volumes do subconjunto k. Um subconjunto vazio dá um volume degenerado na origem.
+template<typename T>
+aabb3<T> computeAABB3(const cloud3<T>& cloud, std::size_t k);
+template<typename T>
+sphere3<T> computeSphere(const cloud3<T>& cloud, std::size_t k, int method = SPHERE_CENTROID);
+template<typename T>
+obb3<T> computeOBB3(const cloud3<T>& cloud, std::size_t k);     // Eixos da covariância (PCA, Jacobi)
+
+// Menor esfera que contém 'points' (Welzl). Embaralha 'points'.
+sphere3D minimumSphere(std::vector<vec3>& points);
+
+// Um volume por subconjunto, em paralelo por subconjunto quando há 'pool'
+template<typename T>
+void computeAABB3s(const cloud3<T>& cloud, std::vector<aabb3<T>>& out, threadPool* pool = nullptr);
+template<typename T>
+void computeSpheres(const cloud3<T>& cloud, std::vector<sphere3<T>>& out, threadPool* pool = nullptr, int method = SPHERE_CENTROID);
+template<typename T>
+void computeOBB3s(const cloud3<T>& cloud, std::vector<obb3<T>>& out, threadPool* pool = nullptr);
+
+template<typename T> bool overlapAABB3(const aabb3<T>& a, const aabb3<T>& b);
+template<typename T> bool overlapSpheres(const sphere3<T>& a, const sphere3<T>& b);
+template<typename T> bool overlapOBB3(const obb3<T>& a, const obb3<T>& b);      // 15 eixos separadores
+
+template<typename T> bool pointInAABB3(const aabb3<T>& box, const vector3<T>& p);
+template<typename T> bool pointInSphere(const sphere3<T>& sphere, const vector3<T>& p);
+template<typename T> bool pointInOBB3(const obb3<T>& box, const vector3<T>& p);
+
+// Caixas 3D em SoA, para testar uma contra muitas sem desvios (como aabbSoA)
+template<typename T>
+struct aabb3SoA{
+    std::pmr::vector<T> min_x, min_y, min_z;
+    std::pmr::vector<T> max_x, max_y, max_z;
+
+    explicit aabb3SoA(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    void assign(const std::vector<aabb3<T>>& boxes);
+    std::size_t size() const;
+};
+
+template<typename T>
+void overlapAABB3Batch(const aabb3<T>& box, const aabb3SoA<T>& boxes, std::size_t first, std::size_t last, unsigned char* mask);
+
+// Pares (i < j) que se sobrepõem, em ordem de (i, j), substituindo o conteúdo de
+// 'pairs'. Com 'pool' o triângulo superior é dividido em blocos entre as threads.
+template<typename T>
+void intersectAABB3s(const std::vector<aabb3<T>>& boxes, std::vector<std::pair<int, int>>& pairs, threadPool* pool = nullptr,
+                     std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+template<typename T>
+void intersectSpheres(const std::vector<sphere3<T>>& spheres, std::vector<std::pair<int, int>>& pairs, threadPool* pool = nullptr,
+                      std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+template<typename T>
+void intersectOBB3s(const std::vector<obb3<T>>& boxes, std::vector<std::pair<int, int>>& pairs, threadPool* pool = nullptr,
+                    std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
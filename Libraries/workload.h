@@ -0,0 +1,43 @@
+#pragma once
+#include "point.h"
+#include "parallel.h"
+#include "volumes3d.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Formato dos subconjuntos gerados
+enum workloadShape{
+    WORKLOAD_UNIFORM = 0,       // Quadrado uniforme
+    WORKLOAD_GAUSSIAN = 1,      // Aglomerado gaussiano isotrópico
+    WORKLOAD_ANISOTROPIC = 2,   // Gaussiana alongada e girada (boa para OBB)
+    WORKLOAD_LINES = 3,         // Segmento com pouco ruído (caso ruim para AABB/círculo)
+    WORKLOAD_MIXED = 4          // Cada subconjunto sorteia um dos quatro acima
+};
+
+struct workloadSpec{
+    int subsets;
+    int meanPoints;        // Média de pontos por subconjunto
+    int shape;             // workloadShape
+    double tailIndex;      // Expoente de Pareto dos tamanhos (> 1); <= 1 deixa todos com meanPoints
+    int hotspots;          // Centros de densidade onde os subconjuntos se acumulam e se sobrepõem (0: espalhados)
+    double xMin, xMax;     // Região dos centros dos subconjuntos
+    double yMin, yMax;
+    std::uint64_t seed;
+};
+
+// Valores razoáveis: 'subsets' x 'meanPoints' pontos, formas misturadas, cauda pesada
+workloadSpec defaultWorkload(int subsets, int meanPoints, double xMin, double xMax, double yMin, double yMax, std::uint64_t seed);
+
+bool parseWorkloadShape(const char* name, int& shape);
+const char* workloadShapeName(int shape);
+
+// Acrescenta spec.subsets subconjuntos ao final de 'cloud' e retorna o total de pontos
+// criados. O subconjunto k usa o fluxo randomStream(seed, k), então o resultado é o
+// mesmo com ou sem 'pool' e com qualquer número de threads. Cada tarefa escreve direto
+// no vetor do seu subconjunto.
+std::size_t generateWorkload(const workloadSpec& spec, std::vector<std::vector<ponto2D>>& cloud, threadPool* pool = nullptr);
+
+// Versão 3D, escrita direto na nuvem SoA. z usa a mesma faixa de x. WORKLOAD_LINES
+// vira um retalho plano com pouco ruído na normal (como uma superfície escaneada).
+std::size_t generateWorkload3D(const workloadSpec& spec, cloud3SoA& cloud, threadPool* pool = nullptr);
@@ -0,0 +1,135 @@
+#include "../Libraries/arena.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+#ifdef COUNT_ALLOCATIONS
+std::atomic<std::size_t> heapAllocations{0};
+#endif
+
+std::size_t alignUp(std::size_t value, std::size_t alignment){
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}
+
+#ifdef COUNT_ALLOCATIONS
+// Substitui o operator new global apenas para contar as alocações (build de diagnóstico)
+void* operator new(std::size_t size){
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* p = std::malloc(size ? size : 1)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size){
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept{
+    std::free(p);
+}
+
+std::size_t heapAllocationCount(){
+    return heapAllocations.load(std::memory_order_relaxed);
+}
+#else
+std::size_t heapAllocationCount(){
+    return 0;
+}
+#endif
+
+frameArena::frameArena(std::size_t initialSize): current{0}, offset{0}, stats{0, 0, 0, 0} {
+    addBlock(initialSize);
+}
+
+frameArena::~frameArena(){
+    for(const block& b : blocks){
+        ::operator delete(b.data, std::align_val_t(alignof(std::max_align_t)));
+    }
+}
+
+void frameArena::addBlock(std::size_t minimum){
+    std::size_t size = std::max(minimum, blocks.empty() ? minimum : blocks.back().size * 2);
+    char* data = static_cast<char*>(::operator new(size, std::align_val_t(alignof(std::max_align_t))));
+    blocks.push_back(block{data, size});
+    stats.upstreamBlocks++;
+}
+
+void* frameArena::do_allocate(std::size_t bytes, std::size_t alignment){
+    // Alinha o endereço (não o deslocamento) para aceitar qualquer alinhamento
+    auto place = [&](std::size_t index, std::size_t from){
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(blocks[index].data);
+        return static_cast<std::size_t>(alignUp(base + from, alignment) - base);
+    };
+
+    std::size_t start = place(current, offset);
+
+    while(start + bytes > blocks[current].size){
+        // Usa o próximo bloco já existente; no fim da lista pede outro ao heap
+        current++;
+        if(current == blocks.size()){
+            addBlock(bytes + alignment);
+        }
+        start = place(current, 0);
+    }
+
+    offset = start + bytes;
+    stats.allocations++;
+    stats.bytes += bytes;
+    return blocks[current].data + start;
+}
+
+void frameArena::do_deallocate(void*, std::size_t, std::size_t){
+    // A memória só volta no reset()
+}
+
+bool frameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept{
+    return this == &other;
+}
+
+void frameArena::reset(){
+    stats.peakBytes = std::max(stats.peakBytes, stats.bytes);
+
+    if(blocks.size() > 1){
+        // O quadro não coube em um bloco: troca todos por um só com a soma dos tamanhos
+        std::size_t total = 0;
+        for(const block& b : blocks){
+            total += b.size;
+            ::operator delete(b.data, std::align_val_t(alignof(std::max_align_t)));
+        }
+        blocks.clear();
+        addBlock(total);
+    }
+
+    current = 0;
+    offset = 0;
+    stats.allocations = 0;
+    stats.bytes = 0;
+}
+
+arenaStats frameArena::getStats() const{
+    return stats;
+}
+
+frameArena& frameScratch(){
+    static frameArena arena;
+    return arena;
+}
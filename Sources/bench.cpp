@@ -0,0 +1,322 @@
+#include "../Libraries/bench.h"
+#include "../Libraries/volumes3d.h"
+#include "../Libraries/vecbatch.h"
+#include "../Libraries/quantized.h"
+#include "../Libraries/predicates.h"
+#include "../Libraries/profiler.h"
+#include "../Libraries/random.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <vector>
+
+namespace {
+
+// Duração de work() em milissegundos, no relógio do profiler
+template<typename Work>
+double timed(Work&& work){
+    long long start = profileNow();
+    work();
+    return (profileNow() - start) * 1e-6;
+}
+
+// Nuvem 3D dos modos sem janela: a de --scan ou 'workload' gerado em 3D
+bool loadBenchCloud(const runOptions& options, const workloadSpec& workload, cloud3SoA& cloud3){
+    if(options.scanPath != nullptr){
+        if(!loadCloud3(options.scanPath, cloud3)){
+            return false;
+        }
+    }else{
+        generateWorkload3D(workload, cloud3, &defaultPool());
+    }
+    if(cloud3.subsets() == 0){
+        std::cerr << "Nuvem 3D vazia." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}
+
+// Mede o pipeline 3D (--bench3d) sobre a nuvem de --scan ou sobre 'workload' gerado
+// em 3D: uma transformação rígida da nuvem em lote, a construção de AABB3, OBB3 e de
+// cada tipo de esfera e os pares que se sobrepõem (esferas EPOS-14), com uma thread e
+// com o pool padrão. Não abre janela; não há visualização 3D.
+int runBench3D(const runOptions& options, const workloadSpec& workload){
+    cloud3SoA cloud3;
+    if(!loadBenchCloud(options, workload, cloud3)){
+        return -1;
+    }
+
+    std::cout << "Bench 3D: " << cloud3.subsets() << " subconjuntos, " << cloud3.points() << " pontos, "
+              << defaultPool().size() << " threads" << std::endl;
+
+    std::vector<aabb3D> boxes;
+    std::vector<sphere3D> spheres;
+    std::vector<obb3D> obbs;
+    std::vector<std::pair<int, int>> pairs;
+
+    auto report = [&](const char* name, double serial, double parallel, std::size_t count){
+        std::cout << "  " << name << ": serial " << serial << " ms | pool " << parallel << " ms";
+        if(count != std::size_t(-1)){
+            std::cout << " | " << count << " pares";
+        }
+        std::cout << std::endl;
+    };
+
+    threadPool* pool = &defaultPool();
+
+    // Rotação rígida da nuvem inteira, no lugar, antes dos ajustes (como um quadro de
+    // um scanner em movimento): em lote, e com o pool em blocos de 64K pontos
+    const double angle = 0.01;
+    const vec3 rows[3] = {vec3(std::cos(angle), -std::sin(angle), 0.0), vec3(std::sin(angle), std::cos(angle), 0.0), vec3(0.0, 0.0, 1.0)};
+    const vec3 shift(0.5, -0.25, 0.125);
+    vec3Span all{cloud3.x.data(), cloud3.y.data(), cloud3.z.data(), cloud3.points()};
+    const std::size_t block = 1 << 16;
+    report("Transformacao", timed([&]{ batchTransform(all, rows, shift, all); }), timed([&]{
+        pool->parallelFor((all.n + block - 1) / block, [&](std::size_t b){
+            std::size_t first = b * block, count = std::min(block, all.n - first);
+            vec3Span part{all.x + first, all.y + first, all.z + first, count};
+            batchTransform(part, rows, shift, part);
+        });
+    }), std::size_t(-1));
+
+    report("AABB3", timed([&]{ computeAABB3s(cloud3, boxes); }), timed([&]{ computeAABB3s(cloud3, boxes, pool); }), std::size_t(-1));
+    report("OBB3", timed([&]{ computeOBB3s(cloud3, obbs); }), timed([&]{ computeOBB3s(cloud3, obbs, pool); }), std::size_t(-1));
+
+    // Esferas: tempo e volume total em relação à menor esfera exata (Welzl)
+    std::vector<sphere3D> exact;
+    computeSpheres(cloud3, exact, pool, SPHERE_WELZL);
+    double exactVolume = 0.0;
+    for(const auto& sphere : exact){
+        exactVolume += sphere.second * sphere.second * sphere.second;
+    }
+    for(int method = 0; method < SPHERE_METHODS; ++method){
+        double serialTime = timed([&]{ computeSpheres(cloud3, spheres, nullptr, method); });
+        double poolTime = timed([&]{ computeSpheres(cloud3, spheres, pool, method); });
+        double volume = 0.0;
+        for(const auto& sphere : spheres){
+            volume += sphere.second * sphere.second * sphere.second;
+        }
+        std::cout << "  Esfera " << sphereMethodName(method) << ": serial " << serialTime << " ms | pool " << poolTime
+                  << " ms | volume / exato " << volume / exactVolume << std::endl;
+    }
+    computeSpheres(cloud3, spheres, pool, SPHERE_EPOS14);
+
+    double serial = timed([&]{ intersectAABB3s(boxes, pairs); });
+    report("Pares AABB3", serial, timed([&]{ intersectAABB3s(boxes, pairs, pool); }), pairs.size());
+    serial = timed([&]{ intersectSpheres(spheres, pairs); });
+    report("Pares esfera", serial, timed([&]{ intersectSpheres(spheres, pairs, pool); }), pairs.size());
+    serial = timed([&]{ intersectOBB3s(obbs, pairs); });
+    report("Pares OBB3", serial, timed([&]{ intersectOBB3s(obbs, pairs, pool); }), pairs.size());
+
+    return 0;
+}
+
+// Compara o pipeline 3D em float com o de double (--check-precision): constrói AABB3,
+// esferas EPOS-14 e OBB3 nas duas precisões e conta (1) pontos guardados fora do
+// próprio volume em float, que deve ser zero, (2) pontos de consulta cuja pertinência
+// difere entre float e double e (3) pares de sobreposição que só uma das precisões
+// encontra. Também imprime os tempos de construção e a maior diferença relativa de
+// tamanho, para comparar com os limites de volumes3d.h.
+int runCheckPrecision(const runOptions& options, const workloadSpec& workload){
+    cloud3SoA cloudD;
+    if(!loadBenchCloud(options, workload, cloudD)){
+        return -1;
+    }
+    cloud3f cloudF;
+    convertCloud(cloudD, cloudF);
+
+    threadPool* pool = &defaultPool();
+    std::vector<aabb3D> boxesD;
+    std::vector<aabb3f> boxesF;
+    std::vector<sphere3D> spheresD;
+    std::vector<sphere3f> spheresF;
+    std::vector<obb3D> obbsD;
+    std::vector<obb3f> obbsF;
+
+    std::cout << "Precisao 3D: " << cloudD.subsets() << " subconjuntos, " << cloudD.points() << " pontos" << std::endl;
+    std::cout << "  AABB3: double " << timed([&]{ computeAABB3s(cloudD, boxesD, pool); }) << " ms | float "
+              << timed([&]{ computeAABB3s(cloudF, boxesF, pool); }) << " ms" << std::endl;
+    std::cout << "  Esfera: double " << timed([&]{ computeSpheres(cloudD, spheresD, pool, SPHERE_EPOS14); }) << " ms | float "
+              << timed([&]{ computeSpheres(cloudF, spheresF, pool, SPHERE_EPOS14); }) << " ms" << std::endl;
+    std::cout << "  OBB3: double " << timed([&]{ computeOBB3s(cloudD, obbsD, pool); }) << " ms | float "
+              << timed([&]{ computeOBB3s(cloudF, obbsF, pool); }) << " ms" << std::endl;
+
+    // Maior diferença de tamanho em relação à magnitude das coordenadas do subconjunto
+    double sizeError = 0.0;
+    for(std::size_t k = 0; k < cloudD.subsets(); ++k){
+        vec3 c = spheresD[k].first;
+        double scale = std::max({std::fabs(c.x), std::fabs(c.y), std::fabs(c.z), spheresD[k].second});
+        double difference = std::fabs(double(spheresF[k].second) - spheresD[k].second);
+        difference = std::max(difference, std::fabs(double(boxesF[k].max_x) - boxesD[k].max_x));
+        difference = std::max(difference, std::fabs(double(boxesF[k].min_x) - boxesD[k].min_x));
+        for(int i = 0; i < 3; ++i){
+            difference = std::max(difference, std::fabs(double(obbsF[k].half_sizes.component(i)) - obbsD[k].half_sizes.component(i)));
+        }
+        sizeError = std::max(sizeError, difference / scale);
+    }
+
+    // Pertinência: os pontos guardados no próprio volume e, como consultas, os mesmos
+    // pontos deslocados ao acaso por até 1% do raio, testados nos dois volumes
+    const char* names[3] = {"AABB3", "Esfera", "OBB3"};
+    xoshiro256ss& gen = threadRandom();
+    std::size_t outside[3] = {0, 0, 0}, differ[3] = {0, 0, 0}, queries = 0;
+    for(std::size_t k = 0; k < cloudD.subsets(); ++k){
+        double jitter = 0.01 * spheresD[k].second;
+        for(std::size_t i = cloudD.begin(k); i < cloudD.end(k); ++i){
+            vec3f stored = cloudF.point(i);
+            outside[0] += !pointInAABB3(boxesF[k], stored);
+            outside[1] += !pointInSphere(spheresF[k], stored);
+            outside[2] += !pointInOBB3(obbsF[k], stored);
+
+            vec3 q = cloudD.point(i) + vec3(randomUniform(gen, -jitter, jitter), randomUniform(gen, -jitter, jitter), randomUniform(gen, -jitter, jitter));
+            vec3f qf(float(q.x), float(q.y), float(q.z));
+            differ[0] += pointInAABB3(boxesD[k], q) != pointInAABB3(boxesF[k], qf);
+            differ[1] += pointInSphere(spheresD[k], q) != pointInSphere(spheresF[k], qf);
+            differ[2] += pointInOBB3(obbsD[k], q) != pointInOBB3(obbsF[k], qf);
+            ++queries;
+        }
+    }
+
+    // Sobreposição: diferença simétrica das listas de pares
+    auto comparePairs = [&](auto& volumesD, auto& volumesF, auto intersectD, auto intersectF, std::size_t& onlyD, std::size_t& onlyF){
+        std::vector<std::pair<int, int>> pairsD, pairsF, difference;
+        intersectD(volumesD, pairsD, pool, std::pmr::get_default_resource());
+        intersectF(volumesF, pairsF, pool, std::pmr::get_default_resource());
+        std::sort(pairsD.begin(), pairsD.end());
+        std::sort(pairsF.begin(), pairsF.end());
+        std::set_difference(pairsD.begin(), pairsD.end(), pairsF.begin(), pairsF.end(), std::back_inserter(difference));
+        onlyD = difference.size();
+        difference.clear();
+        std::set_difference(pairsF.begin(), pairsF.end(), pairsD.begin(), pairsD.end(), std::back_inserter(difference));
+        onlyF = difference.size();
+        return pairsD.size();
+    };
+    std::size_t onlyD[3], onlyF[3], total[3];
+    total[0] = comparePairs(boxesD, boxesF, intersectAABB3s<double>, intersectAABB3s<float>, onlyD[0], onlyF[0]);
+    total[1] = comparePairs(spheresD, spheresF, intersectSpheres<double>, intersectSpheres<float>, onlyD[1], onlyF[1]);
+    total[2] = comparePairs(obbsD, obbsF, intersectOBB3s<double>, intersectOBB3s<float>, onlyD[2], onlyF[2]);
+
+    for(int v = 0; v < 3; ++v){
+        std::cout << "  " << names[v] << ": " << outside[v] << " pontos fora em float | " << differ[v] << " de " << queries
+                  << " consultas diferem | pares " << total[v] << " em double, " << onlyD[v] << " so em double, "
+                  << onlyF[v] << " so em float" << std::endl;
+    }
+    std::cout << "  Maior diferenca de tamanho / magnitude: " << sizeError << std::endl;
+
+    return (outside[0] + outside[1] + outside[2]) == 0 ? 0 : 1;
+}
+
+namespace {
+
+// Compara a nuvem 2D quantizada em I com a original em double (--quantize): memória,
+// tempo de construção de AABBs e círculos, se os volumes conservadores contêm todos
+// os pontos originais e quanto maiores ficam, e os predicados de segmentos. Na grade os
+// predicados inteiros têm de concordar com os adaptativos sobre os pontos decodificados
+// (que são exatos); contra os pontos originais podem discordar em casos quase degenerados.
+template<typename I>
+int runQuantizedAs(const std::vector<std::vector<ponto2D>>& points){
+    quantizedCloud2D<I> quantized;
+    double quantizeTime = timed([&]{ quantizeCloud(points, quantized); });
+
+    std::size_t total = 0;
+    for(const auto& sub : points){
+        total += sub.size();
+    }
+    std::size_t doubleBytes = total * sizeof(ponto2D) + points.size() * sizeof(std::vector<ponto2D>);
+
+    std::cout << "Quantizacao em " << 8 * sizeof(I) << " bits: " << points.size() << " subconjuntos, " << total
+              << " pontos, passo " << quantized.step << " (" << quantizeTime << " ms)" << std::endl;
+    std::cout << "  Memoria: double " << doubleBytes << " bytes | quantizada " << quantized.bytes() << " bytes ("
+              << double(doubleBytes) / quantized.bytes() << "x menor)" << std::endl;
+
+    // Volumes: os de double como em calculateAABB/calculateCircle
+    std::vector<aabb2D> boxes, quantizedBoxes;
+    std::vector<circle2D> discs, quantizedDiscs;
+    double boxTime = timed([&]{
+        boxes.clear();
+        for(const auto& sub : points){
+            ponto2D lo = sub.front(), hi = sub.front();
+            for(const auto& p : sub){
+                lo = minimum(lo, p);
+                hi = maximum(hi, p);
+            }
+            boxes.push_back(aabb2D{lo.x, lo.y, hi.x, hi.y});
+        }
+    });
+    double discTime = timed([&]{
+        discs.clear();
+        for(const auto& sub : points){
+            ponto2D centroid = calculateCentroid(sub);
+            double raio2 = 0.0;
+            for(const auto& p : sub){
+                raio2 = std::max(raio2, distanceSquared(centroid, p));
+            }
+            discs.emplace_back(centroid, std::sqrt(raio2));
+        }
+    });
+    double quantizedBoxTime = timed([&]{ quantizedAABBs(quantized, quantizedBoxes); });
+    double quantizedDiscTime = timed([&]{ quantizedCircles(quantized, quantizedDiscs); });
+
+    std::size_t outside[2] = {0, 0};
+    double area[2] = {0.0, 0.0}, quantizedArea[2] = {0.0, 0.0};
+    for(std::size_t k = 0; k < points.size(); ++k){
+        for(const auto& p : points[k]){
+            const aabb2D& box = quantizedBoxes[k];
+            outside[0] += !(p.x >= box.min_x && p.x <= box.max_x && p.y >= box.min_y && p.y <= box.max_y);
+            outside[1] += distanceSquared(p, quantizedDiscs[k].first) > quantizedDiscs[k].second * quantizedDiscs[k].second;
+        }
+        area[0] += (boxes[k].max_x - boxes[k].min_x) * (boxes[k].max_y - boxes[k].min_y);
+        quantizedArea[0] += (quantizedBoxes[k].max_x - quantizedBoxes[k].min_x) * (quantizedBoxes[k].max_y - quantizedBoxes[k].min_y);
+        area[1] += discs[k].second * discs[k].second;
+        quantizedArea[1] += quantizedDiscs[k].second * quantizedDiscs[k].second;
+    }
+    std::cout << "  AABB: double " << boxTime << " ms | quantizada " << quantizedBoxTime << " ms | " << outside[0]
+              << " pontos originais fora | area / double " << quantizedArea[0] / area[0] << std::endl;
+    std::cout << "  Circulo: double " << discTime << " ms | quantizado " << quantizedDiscTime << " ms | " << outside[1]
+              << " pontos originais fora | area / double " << quantizedArea[1] / area[1] << std::endl;
+
+    // Segmentos (i, i + 1) contra (i + 2, i + 3) de cada subconjunto e o primeiro
+    // segmento de cada subconjunto contra o do seguinte
+    std::size_t tests = 0, hits = 0, decodedMismatch = 0, originalMismatch = 0;
+    auto compare = [&](std::size_t k, std::size_t a, std::size_t l, std::size_t c){
+        bool exact = segmentsIntersectLattice(quantized.lattice(k, quantized.begin(k) + a), quantized.lattice(k, quantized.begin(k) + a + 1),
+                                              quantized.lattice(l, quantized.begin(l) + c), quantized.lattice(l, quantized.begin(l) + c + 1));
+        bool decoded = segmentsIntersect(quantized.point(k, quantized.begin(k) + a), quantized.point(k, quantized.begin(k) + a + 1),
+                                         quantized.point(l, quantized.begin(l) + c), quantized.point(l, quantized.begin(l) + c + 1));
+        bool original = segmentsIntersect(points[k][a], points[k][a + 1], points[l][c], points[l][c + 1]);
+        ++tests;
+        hits += exact;
+        decodedMismatch += exact != decoded;
+        originalMismatch += exact != original;
+    };
+    for(std::size_t k = 0; k < points.size(); ++k){
+        for(std::size_t i = 0; i + 3 < points[k].size(); i += 2){
+            compare(k, i, k, i + 2);
+        }
+        if(k + 1 < points.size() && points[k].size() >= 2 && points[k + 1].size() >= 2){
+            compare(k, 0, k + 1, 0);
+        }
+    }
+    std::cout << "  Segmentos: " << tests << " pares, " << hits << " se tocam | " << decodedMismatch
+              << " diferem dos predicados adaptativos na grade | " << originalMismatch << " diferem nos pontos originais" << std::endl;
+
+    return (outside[0] + outside[1] + decodedMismatch) == 0 ? 0 : 1;
+}
+
+}
+
+int runQuantized(const runOptions& options, const workloadSpec& workload){
+    std::vector<std::vector<ponto2D>> points;
+    generateWorkload(workload, points, &defaultPool());
+    points.erase(std::remove_if(points.begin(), points.end(), [](const std::vector<ponto2D>& sub){ return sub.empty(); }), points.end());
+    if(points.empty()){
+        std::cerr << "Nuvem 2D vazia." << std::endl;
+        return -1;
+    }
+    return options.quantizeBits == 16 ? runQuantizedAs<std::int16_t>(points) : runQuantizedAs<std::int32_t>(points);
+}
@@ -0,0 +1,566 @@
+#include "../Libraries/collision.h"
+#include "../Libraries/predicates.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+contactBuffer::contactBuffer(): used{0} {}
+
+void contactBuffer::reserve(std::size_t count){
+    if(items.size() < count){
+        items.resize(count);
+    }
+}
+
+void contactBuffer::clear(){
+    used = 0;
+}
+
+contact& contactBuffer::push(){
+    if(used == items.size()){
+        items.emplace_back();
+    }
+    return items[used++];
+}
+
+std::size_t contactBuffer::size() const{
+    return used;
+}
+
+bool contactBuffer::empty() const{
+    return used == 0;
+}
+
+const contact& contactBuffer::operator[](std::size_t k) const{
+    return items[k];
+}
+
+const contact* contactBuffer::begin() const{
+    return items.data();
+}
+
+const contact* contactBuffer::end() const{
+    return items.data() + used;
+}
+
+std::vector<std::vector<contact>>& contactBuffer::tiles(std::size_t count){
+    if(scratch.size() < count){
+        scratch.resize(count);
+    }
+    for(auto& tile : scratch){
+        tile.clear();
+    }
+    return scratch;
+}
+
+void contactBuffer::mergeTiles(){
+    clear();
+    for(const auto& tile : scratch){
+        for(const contact& c : tile){
+            push() = c;
+        }
+    }
+
+    // Os blocos visitam as linhas fora de ordem; cada par (i, j) aparece uma única
+    // vez, então ordenar pela chave reproduz a ordem da versão serial.
+    std::sort(items.begin(), items.begin() + used, [](const contact& a, const contact& b){
+        return a.i != b.i ? a.i < b.i : a.j < b.j;
+    });
+}
+
+namespace {
+
+// Tamanho do bloco do triângulo superior: 64 x 64 volumes cabem folgados no L1
+const std::size_t tileSize = 64;
+
+// row(i, first, last, emit) testa o volume i contra [first, last), todos com índice > i.
+template<typename Row>
+void runRows(std::size_t n, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch, Row row){
+    out.clear();
+
+    if(pool == nullptr){
+        for(std::size_t i = 0; i < n; ++i){
+            row(i, i + 1, n, [&](const contact& c){ out.push() = c; });
+        }
+        return;
+    }
+
+    std::pmr::vector<pairTile> tiles = upperTriangleTiles(n, tileSize, scratch);
+    std::vector<std::vector<contact>>& perTile = out.tiles(tiles.size());
+
+    pool->parallelFor(tiles.size(), [&](std::size_t t){
+        const pairTile& tile = tiles[t];
+        for(std::size_t i = tile.i_begin; i < tile.i_end; ++i){
+            row(i, std::max(tile.j_begin, i + 1), tile.j_end, [&](const contact& c){ perTile[t].push_back(c); });
+        }
+    });
+
+    out.mergeTiles();
+}
+
+// Normal e penetração de uma caixa: eixo de menor separação necessária
+void aabbContact(const aabb2D& a, const aabb2D& b, contact& c){
+    double right = a.max_x - b.min_x;
+    double left = b.max_x - a.min_x;
+    double up = a.max_y - b.min_y;
+    double down = b.max_y - a.min_y;
+
+    double depth_x = std::min(right, left);
+    double depth_y = std::min(up, down);
+
+    if(depth_x < depth_y){
+        c.depth = depth_x;
+        c.normal = ponto2D(right < left ? 1.0 : -1.0, 0.0);
+    }else{
+        c.depth = depth_y;
+        c.normal = ponto2D(0.0, up < down ? 1.0 : -1.0);
+    }
+}
+
+bool aabbPair(const aabb2D& a, const aabb2D& b, contact& c){
+    aabb2D overlap;
+    if(!overlapAABB(a, b, overlap)){
+        return false;
+    }
+
+    c.count = aabbCrossings(a, b, overlap, c.points);
+    if(c.count == 0){
+        // Uma caixa contém a outra: os cantos da caixa interna são os contatos
+        for(int k = 0; k < 4; ++k){
+            c.points[k] = overlap.corner(k);
+        }
+        c.count = 4;
+    }
+
+    aabbContact(a, b, c);
+    return true;
+}
+
+template<typename Emit>
+void aabbRow(std::size_t i, std::size_t first, std::size_t last, const std::vector<aabb2D>& boxes, const aabbSoA& soa, Emit emit){
+    if(first >= last){
+        return;
+    }
+
+    thread_local std::vector<unsigned char> mask;
+    mask.resize(last - first);
+    overlapAABBBatch(boxes[i], soa, first, last, mask.data());
+
+    for(std::size_t j = first; j < last; ++j){
+        if(!mask[j - first]){
+            continue;
+        }
+
+        contact c;
+        c.i = i;
+        c.j = j;
+        aabbPair(boxes[i], boxes[j], c);
+        emit(c);
+    }
+}
+
+// Dois circulos colidem se a soma de seus raios for igual (eles se tocam) ou se a soma
+// for menor (um circulo passa por dentro do outro) à distancia entre seus centros
+bool circlePair(const circle2D& c1, const circle2D& c2, contact& c){
+    ponto2D center = c1.first;
+    double distancia = distance(center, c2.first);
+
+    if(distancia > c1.second + c2.second){
+        return false;
+    }
+
+    c.count = 0;
+    c.depth = c1.second + c2.second - distancia;
+    c.normal = distancia > 0.0 ? (c2.first - center) * (1.0 / distancia) : ponto2D(1.0, 0.0);
+
+    // Um dentro do outro (ou concêntricos): há contato, mas as bordas não se cruzam
+    if(distancia == 0.0 || distancia < std::abs(c1.second - c2.second)){
+        return true;
+    }
+
+    double a = c1.second * c1.second - c2.second * c2.second + distancia * distancia;
+    a /= (2 * distancia);
+
+    double h = std::sqrt(std::max(0.0, c1.second * c1.second - a * a));
+
+    ponto2D p0;
+    p0.x = center.x + (a * (c2.first.x - center.x)) / distancia;
+    p0.y = center.y + (a * (c2.first.y - center.y)) / distancia;
+
+    if (h == 0) {
+        // Um ponto de interseção
+        c.points[c.count++] = p0;
+    } else {
+        // Dois pontos de interseção
+        ponto2D p1, p2;
+        p1.x = p0.x + (h * (c2.first.y - center.y)) / distancia;
+        p1.y = p0.y - (h * (c2.first.x - center.x)) / distancia;
+
+        p2.x = p0.x - (h * (c2.first.y - center.y)) / distancia;
+        p2.y = p0.y + (h * (c2.first.x - center.x)) / distancia;
+
+        c.points[c.count++] = p1;
+        c.points[c.count++] = p2;
+    }
+
+    return true;
+}
+
+void obbCorners(const obb2D& box, ponto2D corners[4]){
+    const auto& [center, half_sizes, U, V] = box;
+    corners[0] = center + U * half_sizes.x + V * half_sizes.y;
+    corners[1] = center - U * half_sizes.x + V * half_sizes.y;
+    corners[2] = center - U * half_sizes.x - V * half_sizes.y;
+    corners[3] = center + U * half_sizes.x - V * half_sizes.y;
+}
+
+bool insideOBB(const obb2D& box, const ponto2D& p){
+    const auto& [center, half_sizes, U, V] = box;
+    ponto2D d = p - center;
+    return std::abs(dot(d, U)) <= half_sizes.x &&
+           std::abs(dot(d, V)) <= half_sizes.y;
+}
+
+// Teorema do eixo separador: os únicos eixos candidatos são U e V de cada caixa
+bool obbPair(const obb2D& a, const obb2D& b, contact& c){
+    const auto& [center_a, half_a, U_a, V_a] = a;
+    const auto& [center_b, half_b, U_b, V_b] = b;
+
+    ponto2D d = center_b - center_a;
+    const ponto2D axes[4] = {U_a, V_a, U_b, V_b};
+
+    c.depth = std::numeric_limits<double>::infinity();
+    for(const ponto2D& axis : axes){
+        double ra = half_a.x * std::abs(dot(U_a, axis)) + half_a.y * std::abs(dot(V_a, axis));
+        double rb = half_b.x * std::abs(dot(U_b, axis)) + half_b.y * std::abs(dot(V_b, axis));
+        double dist = dot(d, axis);
+
+        double overlap = ra + rb - std::abs(dist);
+        if(overlap < 0.0){
+            return false;
+        }
+        if(overlap < c.depth){
+            c.depth = overlap;
+            c.normal = dist >= 0.0 ? axis : axis * -1.0;
+        }
+    }
+
+    // Contatos: cruzamentos das arestas e cantos de uma caixa dentro da outra
+    ponto2D ca[4], cb[4];
+    obbCorners(a, ca);
+    obbCorners(b, cb);
+
+    // Arestas colineares geram o mesmo ponto por mais de um caminho
+    c.count = 0;
+    auto add = [&c](const ponto2D& p){
+        for(int k = 0; k < c.count; ++k){
+            if(c.points[k].x == p.x && c.points[k].y == p.y){
+                return;
+            }
+        }
+        if(c.count < 8){
+            c.points[c.count++] = p;
+        }
+    };
+
+    for(int k = 0; k < 4; ++k){
+        for(int l = 0; l < 4; ++l){
+            ponto2D p;
+            if(segmentIntersectionPoint(ca[k], ca[(k + 1) % 4], cb[l], cb[(l + 1) % 4], p)){
+                add(p);
+            }
+        }
+    }
+    for(int k = 0; k < 4; ++k){
+        if(insideOBB(b, ca[k])){
+            add(ca[k]);
+        }
+        if(insideOBB(a, cb[k])){
+            add(cb[k]);
+        }
+    }
+
+    return true;
+}
+
+// Pontos mais próximos dos eixos; o contato fica no meio da região sobreposta
+bool capsulePair(const capsule2D& a, const capsule2D& b, contact& c){
+    ponto2D pa, pb;
+    closestSegmentPoints(a.a, a.b, b.a, b.b, pa, pb);
+
+    ponto2D d = pb - pa;
+    double distance2 = lengthSquared(d);
+    double reach = a.radius + b.radius;
+    if(distance2 > reach * reach){
+        return false;
+    }
+
+    double distance = std::sqrt(distance2);
+    if(distance > 0.0){
+        c.normal = d * (1.0 / distance);
+    }else{
+        // Eixos se cruzam: qualquer perpendicular ao eixo de a serve
+        ponto2D axis = a.b - a.a;
+        double norm = length(axis);
+        c.normal = norm > 0.0 ? ponto2D(-axis.y / norm, axis.x / norm) : ponto2D(1.0, 0.0);
+    }
+    c.depth = reach - distance;
+    c.points[0] = pa + c.normal * (a.radius - 0.5 * c.depth);
+    c.count = 1;
+    return true;
+}
+
+bool ellipsePair(const ellipse2D& a, const ellipse2D& b, contact& c){
+    // points[0]: ponto de a mais fundo em b; points[1]: ponto de b mais fundo em a,
+    // e 'bIntoA' a distância dele ao centro de a na métrica de a (a profundidade do cabeçalho)
+    double aIntoB, bIntoA;
+    if(!overlapEllipses(a, b, c.points[0], aIntoB)){
+        return false;
+    }
+    overlapEllipses(b, a, c.points[1], bIntoA);
+    c.count = 2;
+
+    ponto2D d = b.center - a.center;
+    double norm = length(d);
+    c.normal = norm > 0.0 ? d * (1.0 / norm) : ponto2D(1.0, 0.0);
+    c.depth = std::max(0.0, 1.0 - bIntoA) * std::min(a.semi_u, a.semi_v);
+    return true;
+}
+
+// (a x b) x c
+ponto2D tripleProduct(const ponto2D& a, const ponto2D& b, const ponto2D& c){
+    return b * dot(a, c) - a * dot(b, c);
+}
+
+// Atualiza o simplex (último ponto é o mais novo) e a direção de busca.
+// Retorna true se o simplex contém a origem.
+bool gjkSimplex(ponto2D simplex[3], int& count, ponto2D& direction){
+    ponto2D a = simplex[count - 1];
+    ponto2D ao = a * -1.0;
+
+    if(count == 2){
+        ponto2D ab = simplex[0] - a;
+        direction = tripleProduct(ab, ao, ab);
+        if(dot(direction, direction) == 0.0){
+            // Origem sobre o segmento
+            return dot(ab, ao) >= 0.0 && dot(ab, ao) <= dot(ab, ab);
+        }
+        return false;
+    }
+
+    ponto2D b = simplex[1];
+    ponto2D c = simplex[0];
+    ponto2D ab = b - a;
+    ponto2D ac = c - a;
+    ponto2D abPerp = tripleProduct(ac, ab, ab);
+    ponto2D acPerp = tripleProduct(ab, ac, ac);
+
+    if(dot(abPerp, ao) > 0.0){
+        simplex[0] = b;
+        simplex[1] = a;
+        count = 2;
+        direction = abPerp;
+        return false;
+    }
+    if(dot(acPerp, ao) > 0.0){
+        simplex[1] = a;
+        count = 2;
+        direction = acPerp;
+        return false;
+    }
+    return true;
+}
+
+bool volumePair(const taggedVolume& a, const taggedVolume& b, contact& c){
+    if(a.kind == b.kind){
+        switch(a.kind){
+            case VOLUME_AABB: return aabbPair(volumeAABB(a), volumeAABB(b), c);
+            case VOLUME_CIRCLE: return circlePair(volumeCircle(a), volumeCircle(b), c);
+            case VOLUME_OBB: return obbPair(volumeOBB(a), volumeOBB(b), c);
+            case VOLUME_CAPSULE: return capsulePair(volumeCapsule(a), volumeCapsule(b), c);
+            default: return ellipsePair(volumeEllipse(a), volumeEllipse(b), c);
+        }
+    }
+
+    if(!gjkOverlap(a, b)){
+        return false;
+    }
+    ponto2D d = b.center - a.center;
+    double length = ::length(d);
+    c.normal = length > 0.0 ? d * (1.0 / length) : ponto2D(1.0, 0.0);
+    c.depth = 0.0;
+    c.count = 0;
+    return true;
+}
+
+// Eixo de menor sobreposição entre dois k-DOPs que se tocam e os cruzamentos das
+// bordas dos dois polígonos (como em obbPair, até 8 pontos)
+template<int D>
+void kdopContact(const kdop2D<D>& a, const kdop2D<D>& b, contact& c){
+    c.count = 0;
+    c.depth = std::numeric_limits<double>::infinity();
+    for(int k = 0; k < D; ++k){
+        double forward = a.hi[k] - b.lo[k];   // b está adiante de a no eixo
+        double backward = b.hi[k] - a.lo[k];
+        double depth = std::min(forward, backward);
+        if(depth < c.depth){
+            ponto2D axis = kdopAxis<D>(k);
+            c.depth = depth;
+            c.normal = forward <= backward ? axis : axis * -1.0;
+        }
+    }
+
+    ponto2D va[2 * D], vb[2 * D];
+    int na = kdopVertices(a, va);
+    int nb = kdopVertices(b, vb);
+    for(int k = 0; k < na && c.count < 8; ++k){
+        for(int l = 0; l < nb && c.count < 8; ++l){
+            ponto2D p;
+            if(!segmentIntersectionPoint(va[k], va[(k + 1) % na], vb[l], vb[(l + 1) % nb], p)){
+                continue;
+            }
+            // Faces de comprimento zero repetem vértices
+            bool repeated = false;
+            for(int m = 0; m < c.count; ++m){
+                repeated = repeated || (c.points[m].x == p.x && c.points[m].y == p.y);
+            }
+            if(!repeated){
+                c.points[c.count++] = p;
+            }
+        }
+    }
+}
+
+template<int D>
+void intersectKDOPs(const std::vector<kdop2D<D>>& dops, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch){
+    runRows(dops.size(), out, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, auto emit){
+        for(std::size_t j = first; j < last; ++j){
+            // Fase larga: só comparações de faixas; os polígonos só para quem passa
+            if(overlapKDOP(dops[i], dops[j])){
+                contact c;
+                c.i = i;
+                c.j = j;
+                kdopContact(dops[i], dops[j], c);
+                emit(c);
+            }
+        }
+    });
+}
+
+}
+
+void intersectAABBs(const std::vector<aabb2D>& boxes, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch){
+    aabbSoA soa{scratch};
+    soa.assign(boxes);
+
+    runRows(boxes.size(), out, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, auto emit){
+        aabbRow(i, first, last, boxes, soa, emit);
+    });
+}
+
+void intersectCircles(const std::vector<circle2D>& circles, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch){
+    runRows(circles.size(), out, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, auto emit){
+        for(std::size_t j = first; j < last; ++j){
+            contact c;
+            if(circlePair(circles[i], circles[j], c)){
+                c.i = i;
+                c.j = j;
+                emit(c);
+            }
+        }
+    });
+}
+
+void intersectOBBs(const std::vector<obb2D>& boxes, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch){
+    runRows(boxes.size(), out, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, auto emit){
+        for(std::size_t j = first; j < last; ++j){
+            contact c;
+            if(obbPair(boxes[i], boxes[j], c)){
+                c.i = i;
+                c.j = j;
+                emit(c);
+            }
+        }
+    });
+}
+
+void intersectCapsules(const std::vector<capsule2D>& capsules, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch){
+    runRows(capsules.size(), out, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, auto emit){
+        for(std::size_t j = first; j < last; ++j){
+            contact c;
+            if(capsulePair(capsules[i], capsules[j], c)){
+                c.i = i;
+                c.j = j;
+                emit(c);
+            }
+        }
+    });
+}
+
+void intersectEllipses(const std::vector<ellipse2D>& ellipses, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch){
+    runRows(ellipses.size(), out, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, auto emit){
+        for(std::size_t j = first; j < last; ++j){
+            contact c;
+            if(ellipsePair(ellipses[i], ellipses[j], c)){
+                c.i = i;
+                c.j = j;
+                emit(c);
+            }
+        }
+    });
+}
+
+void intersectDOP8s(const std::vector<dop8>& dops, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch){
+    intersectKDOPs(dops, out, pool, scratch);
+}
+
+void intersectDOP16s(const std::vector<dop16>& dops, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch){
+    intersectKDOPs(dops, out, pool, scratch);
+}
+
+bool gjkOverlap(const taggedVolume& a, const taggedVolume& b){
+    // Diferença de Minkowski a - b contém a origem <=> a e b se sobrepõem
+    auto support = [&](const ponto2D& d){
+        return volumeSupport(a, d) - volumeSupport(b, d * -1.0);
+    };
+
+    ponto2D direction = b.center - a.center;
+    if(direction.x == 0.0 && direction.y == 0.0){
+        direction = ponto2D(1.0, 0.0);
+    }
+
+    ponto2D simplex[3];
+    int count = 0;
+    simplex[count++] = support(direction);
+    direction = simplex[0] * -1.0;
+
+    // Em 2D converge em poucas iterações; sem convergência (contato tangente,
+    // erro de arredondamento) a resposta é conservadora: sobrepõem
+    for(int iteration = 0; iteration < 32; ++iteration){
+        if(direction.x == 0.0 && direction.y == 0.0){
+            return true;
+        }
+        ponto2D p = support(direction);
+        if(dot(p, direction) < 0.0){
+            return false;
+        }
+        simplex[count++] = p;
+        if(gjkSimplex(simplex, count, direction)){
+            return true;
+        }
+    }
+    return true;
+}
+
+void intersectVolumes(const std::vector<taggedVolume>& volumes, contactBuffer& out, threadPool* pool, std::pmr::memory_resource* scratch){
+    runRows(volumes.size(), out, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, auto emit){
+        for(std::size_t j = first; j < last; ++j){
+            contact c;
+            if(volumePair(volumes[i], volumes[j], c)){
+                c.i = i;
+                c.j = j;
+                emit(c);
+            }
+        }
+    });
+}
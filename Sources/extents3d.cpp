@@ -0,0 +1,80 @@
+#include "../Libraries/extents3d.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+// Compilado com -ffinite-math-only -fno-signed-zeros: nenhum acumulador começa em
+// infinito, todos começam no primeiro ponto do subconjunto ou em zero.
+
+template<typename T>
+aabb3<T> computeAABB3(const cloud3<T>& cloud, std::size_t k){
+    const T* __restrict x = cloud.x.data();
+    const T* __restrict y = cloud.y.data();
+    const T* __restrict z = cloud.z.data();
+    std::size_t first = cloud.begin(k), last = cloud.end(k);
+    if(first == last){
+        return aabb3<T>{0, 0, 0, 0, 0, 0};
+    }
+
+    aabb3<T> box{x[first], y[first], z[first], x[first], y[first], z[first]};
+    for(std::size_t i = first; i < last; ++i){
+        box.min_x = std::min(box.min_x, x[i]);
+        box.min_y = std::min(box.min_y, y[i]);
+        box.min_z = std::min(box.min_z, z[i]);
+        box.max_x = std::max(box.max_x, x[i]);
+        box.max_y = std::max(box.max_y, y[i]);
+        box.max_z = std::max(box.max_z, z[i]);
+    }
+
+    // Em float cada coordenada guardada está a menos de um ulp da original, então
+    // afastar as faces um ulp faz a caixa conter também os pontos originais
+    if(std::is_same<T, float>::value){
+        const T down = std::numeric_limits<T>::lowest(), up = std::numeric_limits<T>::max();
+        box.min_x = std::nextafter(box.min_x, down);
+        box.min_y = std::nextafter(box.min_y, down);
+        box.min_z = std::nextafter(box.min_z, down);
+        box.max_x = std::nextafter(box.max_x, up);
+        box.max_y = std::nextafter(box.max_y, up);
+        box.max_z = std::nextafter(box.max_z, up);
+    }
+    return box;
+}
+
+template<typename T>
+void projectedExtents3(const cloud3<T>& cloud, std::size_t first, std::size_t last, const vector3<T>& origin,
+                       const vector3<T> axes[3], T lo[3], T hi[3]){
+    const T* __restrict x = cloud.x.data();
+    const T* __restrict y = cloud.y.data();
+    const T* __restrict z = cloud.z.data();
+    T a0 = axes[0].x, a1 = axes[0].y, a2 = axes[0].z;
+    T b0 = axes[1].x, b1 = axes[1].y, b2 = axes[1].z;
+    T c0 = axes[2].x, c1 = axes[2].y, c2 = axes[2].z;
+    T ox = origin.x, oy = origin.y, oz = origin.z;
+
+    T lo0 = 0, hi0 = 0, lo1 = 0, hi1 = 0, lo2 = 0, hi2 = 0;
+    for(std::size_t i = first; i < last; ++i){
+        T dx = x[i] - ox, dy = y[i] - oy, dz = z[i] - oz;
+        T p0 = a0 * dx + a1 * dy + a2 * dz;
+        T p1 = b0 * dx + b1 * dy + b2 * dz;
+        T p2 = c0 * dx + c1 * dy + c2 * dz;
+        lo0 = std::min(lo0, p0);
+        hi0 = std::max(hi0, p0);
+        lo1 = std::min(lo1, p1);
+        hi1 = std::max(hi1, p1);
+        lo2 = std::min(lo2, p2);
+        hi2 = std::max(hi2, p2);
+    }
+
+    lo[0] = lo0;
+    hi[0] = hi0;
+    lo[1] = lo1;
+    hi[1] = hi1;
+    lo[2] = lo2;
+    hi[2] = hi2;
+}
+
+template aabb3<double> computeAABB3(const cloud3<double>&, std::size_t);
+template aabb3<float> computeAABB3(const cloud3<float>&, std::size_t);
+template void projectedExtents3(const cloud3<double>&, std::size_t, std::size_t, const vector3<double>&, const vector3<double>[3], double[3], double[3]);
+template void projectedExtents3(const cloud3<float>&, std::size_t, std::size_t, const vector3<float>&, const vector3<float>[3], float[3], float[3]);
@@ -0,0 +1,179 @@
+#include "../Libraries/hull.h"
+#include "../Libraries/predicates.h"
+#include <algorithm>
+
+namespace {
+
+// Abaixo disso o filtro custa mais do que economiza na ordenação
+const std::size_t prefilterThreshold = 64;
+
+// Pontos por pedaço no modo dividir e conquistar
+const std::size_t parallelChunk = 1 << 15;
+
+bool lessXY(const ponto2D& a, const ponto2D& b){
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+bool sameXY(const ponto2D& a, const ponto2D& b){
+    return a.x == b.x && a.y == b.y;
+}
+
+// Akl–Toussaint: copia para 'out' apenas os pontos que não estão estritamente dentro
+// do octógono dos extremos em x, y, x + y e x - y. Os extremos pertencem ao fecho e o
+// octógono está contido nele, então nenhum vértice do fecho é descartado.
+void akltoussaint(const ponto2D* first, const ponto2D* last, std::pmr::vector<ponto2D>& out){
+    // Extremos em ordem anti-horária: esquerda, inf-esq, baixo, inf-dir, direita, sup-dir, cima, sup-esq
+    ponto2D e[8] = {*first, *first, *first, *first, *first, *first, *first, *first};
+    for(const ponto2D* p = first; p != last; ++p){
+        if(p->x < e[0].x) e[0] = *p;
+        if(p->x + p->y < e[1].x + e[1].y) e[1] = *p;
+        if(p->y < e[2].y) e[2] = *p;
+        if(p->x - p->y > e[3].x - e[3].y) e[3] = *p;
+        if(p->x > e[4].x) e[4] = *p;
+        if(p->x + p->y > e[5].x + e[5].y) e[5] = *p;
+        if(p->y > e[6].y) e[6] = *p;
+        if(p->x - p->y < e[7].x - e[7].y) e[7] = *p;
+    }
+
+    // Arestas do octógono, sem as degeneradas (extremos repetidos)
+    ponto2D edges[8][2];
+    int count = 0;
+    for(int k = 0; k < 8; ++k){
+        const ponto2D& a = e[k];
+        const ponto2D& b = e[(k + 1) % 8];
+        if(!sameXY(a, b)){
+            edges[count][0] = a;
+            edges[count][1] = b;
+            count++;
+        }
+    }
+
+    for(const ponto2D* p = first; p != last; ++p){
+        bool inside = count >= 3;
+        for(int k = 0; k < count && inside; ++k){
+            inside = orient2d(edges[k][0], edges[k][1], *p) > 0;
+        }
+        if(!inside){
+            out.push_back(*p);
+        }
+    }
+}
+
+// Cadeia monótona sobre 'pts' (reordenado no lugar); escreve o fecho em 'out'
+void monotoneChain(std::pmr::vector<ponto2D>& pts, std::vector<ponto2D>& out){
+    std::sort(pts.begin(), pts.end(), lessXY);
+    pts.erase(std::unique(pts.begin(), pts.end(), sameXY), pts.end());
+
+    out.clear();
+    if(pts.size() < 3){
+        out.assign(pts.begin(), pts.end());
+        return;
+    }
+
+    out.resize(2 * pts.size());
+    std::size_t k = 0;
+
+    // Cadeia inferior
+    for(std::size_t i = 0; i < pts.size(); ++i){
+        while(k >= 2 && orient2d(out[k - 2], out[k - 1], pts[i]) <= 0){
+            k--;
+        }
+        out[k++] = pts[i];
+    }
+
+    // Cadeia superior
+    std::size_t lower = k + 1;
+    for(std::size_t i = pts.size() - 1; i-- > 0;){
+        while(k >= lower && orient2d(out[k - 2], out[k - 1], pts[i]) <= 0){
+            k--;
+        }
+        out[k++] = pts[i];
+    }
+
+    // O último ponto repete o primeiro
+    out.resize(k - 1);
+}
+
+void hullOfRange(const ponto2D* first, const ponto2D* last, std::vector<ponto2D>& out, std::pmr::memory_resource* scratch){
+    std::pmr::vector<ponto2D> pts{scratch};
+    std::size_t n = last - first;
+    if(n >= prefilterThreshold){
+        pts.reserve(n / 4);
+        akltoussaint(first, last, pts);
+    }else{
+        pts.assign(first, last);
+    }
+    monotoneChain(pts, out);
+}
+
+}
+
+std::vector<ponto2D> convexHull(const std::vector<ponto2D>& points, threadPool* pool, std::pmr::memory_resource* scratch){
+    std::vector<ponto2D> hull;
+    if(points.empty()){
+        return hull;
+    }
+
+    std::size_t n = points.size();
+    if(pool == nullptr || n < 2 * parallelChunk){
+        hullOfRange(points.data(), points.data() + n, hull, scratch);
+        return hull;
+    }
+
+    // Os fechos parciais usam o heap: o recurso de rascunho pode não ser thread-safe
+    std::size_t chunks = (n + parallelChunk - 1) / parallelChunk;
+    std::vector<std::vector<ponto2D>> partial(chunks);
+    pool->parallelFor(chunks, [&](std::size_t c){
+        std::size_t begin = c * parallelChunk;
+        std::size_t end = std::min(n, begin + parallelChunk);
+        hullOfRange(points.data() + begin, points.data() + end, partial[c], std::pmr::get_default_resource());
+    });
+
+    std::pmr::vector<ponto2D> merged{scratch};
+    for(const auto& part : partial){
+        merged.insert(merged.end(), part.begin(), part.end());
+    }
+    monotoneChain(merged, hull);
+    return hull;
+}
+
+void computeHulls(const std::vector<std::vector<ponto2D>>& cloud, std::vector<std::vector<ponto2D>>& hulls, threadPool* pool){
+    hulls.resize(cloud.size());
+    // Subconjuntos enormes ainda dividem o próprio fecho entre as threads
+    forEachIndex(pool, cloud.size(), [&](std::size_t k){
+        hulls[k] = convexHull(cloud[k], pool);
+    });
+}
+
+bool pointInConvexPolygon(const std::vector<ponto2D>& hull, const ponto2D& p){
+    std::size_t n = hull.size();
+    if(n == 0){
+        return false;
+    }
+    if(n == 1){
+        return sameXY(hull[0], p);
+    }
+    if(n == 2){
+        return orient2d(hull[0], hull[1], p) == 0 &&
+               std::min(hull[0].x, hull[1].x) <= p.x && p.x <= std::max(hull[0].x, hull[1].x) &&
+               std::min(hull[0].y, hull[1].y) <= p.y && p.y <= std::max(hull[0].y, hull[1].y);
+    }
+
+    // Fora da cunha formada por hull[0], hull[1] e hull[n - 1]
+    if(orient2d(hull[0], hull[1], p) < 0 || orient2d(hull[0], hull[n - 1], p) > 0){
+        return false;
+    }
+
+    // Maior k em [1, n - 2] com p à esquerda (ou sobre) de hull[0] -> hull[k]
+    std::size_t lo = 1, hi = n - 2;
+    while(lo < hi){
+        std::size_t mid = (lo + hi + 1) / 2;
+        if(orient2d(hull[0], hull[mid], p) >= 0){
+            lo = mid;
+        }else{
+            hi = mid - 1;
+        }
+    }
+
+    return orient2d(hull[lo], hull[lo + 1], p) >= 0;
+}
@@ -0,0 +1,136 @@
+#include "../Libraries/options.h"
+#include "../Libraries/workload.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+void printUsage(const char* program){
+    std::cerr << "Uso: " << program << " [opcoes]\n"
+              << "  --headless        Renderiza fora da tela, o mais rapido possivel, e imprime os tempos\n"
+              << "  --frames N        Quadros no modo headless (padrao 600)\n"
+              << "  --subsets N       Subconjuntos da cena do modo headless (padrao 50)\n"
+              << "  --record ARQUIVO  Grava teclas, cliques e a semente para reproducao\n"
+              << "  --replay ARQUIVO  Reproduz uma gravacao (com --headless, na velocidade maxima)\n"
+              << "  --seed N          Semente do gerador aleatorio\n"
+              << "  --workload FORMA  Cena sintetica: uniform, gaussian, anisotropic, lines ou mixed\n"
+              << "  --points N        Media de pontos por subconjunto da cena sintetica (padrao 5)\n"
+              << "  --bench3d         Mede AABB3, esfera e OBB3 sobre uma nuvem 3D e sai (sem janela)\n"
+              << "  --scan ARQUIVO    Nuvem 3D do --bench3d e do --check-precision, 'x y z' por linha, subconjuntos separados por linha em branco\n"
+              << "  --check-precision Compara pertinencia e sobreposicao dos volumes 3D em float e em double e sai\n"
+              << "  --load ARQUIVO    Carrega subconjuntos 2D 'x y' em segundo plano, separados por linha em branco\n"
+              << "  --quantize BITS   Compara a nuvem 2D em inteiros de 16 ou 32 bits com a em double e sai\n"
+              << "  --calibrate       Mede os custos de teste de cada volume (tecla M) nesta maquina\n"
+              << "  --looseness R     Maior area do volume / area do fecho aceita pela tecla M (padrao 1.6)\n"
+              << "  --help            Mostra esta mensagem\n";
+}
+
+// Lê o inteiro positivo que segue a opção argv[i]
+bool readCount(int argc, char** argv, int& i, int& out){
+    if(i + 1 >= argc){
+        std::cerr << "Faltou o valor de " << argv[i] << std::endl;
+        return false;
+    }
+    char* end;
+    long value = std::strtol(argv[++i], &end, 10);
+    if(*end != '\0' || value <= 0){
+        std::cerr << "Valor invalido para " << argv[i - 1] << ": " << argv[i] << std::endl;
+        return false;
+    }
+    out = int(value);
+    return true;
+}
+
+// Lê o real maior que 1 que segue a opção argv[i]
+bool readRatio(int argc, char** argv, int& i, double& out){
+    if(i + 1 >= argc){
+        std::cerr << "Faltou o valor de " << argv[i] << std::endl;
+        return false;
+    }
+    char* end;
+    double value = std::strtod(argv[++i], &end);
+    if(*end != '\0' || !(value > 1.0)){
+        std::cerr << "Valor invalido para " << argv[i - 1] << ": " << argv[i] << std::endl;
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+// Lê o caminho de arquivo que segue a opção argv[i]
+bool readPath(int argc, char** argv, int& i, const char*& out){
+    if(i + 1 >= argc){
+        std::cerr << "Faltou o arquivo de " << argv[i] << std::endl;
+        return false;
+    }
+    out = argv[++i];
+    return true;
+}
+
+}
+
+bool parseOptions(int argc, char** argv, runOptions& options){
+    options = runOptions{false, 600, 50, nullptr, nullptr, false, 0, -1, 5, false, nullptr, false, nullptr, 0, false, 0.0};
+
+    for(int i = 1; i < argc; ++i){
+        if(std::strcmp(argv[i], "--headless") == 0){
+            options.headless = true;
+        }else if(std::strcmp(argv[i], "--frames") == 0){
+            if(!readCount(argc, argv, i, options.frames)) return false;
+        }else if(std::strcmp(argv[i], "--subsets") == 0){
+            if(!readCount(argc, argv, i, options.subsets)) return false;
+        }else if(std::strcmp(argv[i], "--record") == 0){
+            if(!readPath(argc, argv, i, options.recordPath)) return false;
+        }else if(std::strcmp(argv[i], "--replay") == 0){
+            if(!readPath(argc, argv, i, options.replayPath)) return false;
+        }else if(std::strcmp(argv[i], "--seed") == 0){
+            if(i + 1 >= argc){
+                std::cerr << "Faltou o valor de --seed" << std::endl;
+                return false;
+            }
+            char* end;
+            options.seed = std::strtoull(argv[++i], &end, 10);
+            if(*end != '\0'){
+                std::cerr << "Semente invalida: " << argv[i] << std::endl;
+                return false;
+            }
+            options.hasSeed = true;
+        }else if(std::strcmp(argv[i], "--workload") == 0){
+            if(i + 1 >= argc || !parseWorkloadShape(argv[i + 1], options.workload)){
+                std::cerr << "Forma invalida para --workload" << std::endl;
+                printUsage(argv[0]);
+                return false;
+            }
+            i++;
+        }else if(std::strcmp(argv[i], "--points") == 0){
+            if(!readCount(argc, argv, i, options.points)) return false;
+        }else if(std::strcmp(argv[i], "--bench3d") == 0){
+            options.bench3d = true;
+        }else if(std::strcmp(argv[i], "--scan") == 0){
+            if(!readPath(argc, argv, i, options.scanPath)) return false;
+        }else if(std::strcmp(argv[i], "--check-precision") == 0){
+            options.checkPrecision = true;
+        }else if(std::strcmp(argv[i], "--load") == 0){
+            if(!readPath(argc, argv, i, options.loadPath)) return false;
+        }else if(std::strcmp(argv[i], "--quantize") == 0){
+            if(!readCount(argc, argv, i, options.quantizeBits)) return false;
+            if(options.quantizeBits != 16 && options.quantizeBits != 32){
+                std::cerr << "--quantize aceita 16 ou 32 bits" << std::endl;
+                return false;
+            }
+        }else if(std::strcmp(argv[i], "--calibrate") == 0){
+            options.calibrate = true;
+        }else if(std::strcmp(argv[i], "--looseness") == 0){
+            if(!readRatio(argc, argv, i, options.looseness)) return false;
+        }else{
+            if(std::strcmp(argv[i], "--help") != 0){
+                std::cerr << "Opcao desconhecida: " << argv[i] << std::endl;
+            }
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    return true;
+}
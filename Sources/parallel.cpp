@@ -0,0 +1,107 @@
+#include "../Libraries/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+threadPool::threadPool(unsigned int count): stopping{false} {
+    count = std::max(1u, count);
+    for(unsigned int i = 0; i < count; ++i){
+        workers.emplace_back([this]{ workerLoop(); });
+    }
+}
+
+threadPool::~threadPool(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for(auto& worker : workers){
+        worker.join();
+    }
+}
+
+unsigned int threadPool::size() const{
+    return workers.size();
+}
+
+void threadPool::workerLoop(){
+    for(;;){
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]{ return stopping || !tasks.empty(); });
+            if(stopping && tasks.empty()){
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void threadPool::submit(std::function<void()> task){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    available.notify_one();
+}
+
+void threadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn){
+    if(count == 0){
+        return;
+    }
+    if(count == 1){
+        fn(0);
+        return;
+    }
+
+    // Os índices são distribuídos dinamicamente por um contador atômico.
+    struct job{
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<job>();
+
+    auto run = [state, count, &fn]{
+        std::size_t k;
+        std::size_t local = 0;
+        while((k = state->next.fetch_add(1)) < count){
+            fn(k);
+            local++;
+        }
+        if(local > 0 && state->done.fetch_add(local) + local == count){
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished.notify_all();
+        }
+    };
+
+    std::size_t helpers = std::min<std::size_t>(workers.size(), count - 1);
+    for(std::size_t h = 0; h < helpers; ++h){
+        submit(run);
+    }
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&]{ return state->done.load() == count; });
+}
+
+threadPool& defaultPool(){
+    static threadPool pool;
+    return pool;
+}
+
+std::pmr::vector<pairTile> upperTriangleTiles(std::size_t n, std::size_t tile, std::pmr::memory_resource* memory){
+    std::pmr::vector<pairTile> tiles{memory};
+    tile = std::max<std::size_t>(1, tile);
+    for(std::size_t i = 0; i < n; i += tile){
+        for(std::size_t j = i; j < n; j += tile){
+            tiles.push_back(pairTile{i, std::min(i + tile, n), j, std::min(j + tile, n)});
+        }
+    }
+    return tiles;
+}
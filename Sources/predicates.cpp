@@ -0,0 +1,303 @@
+#include "../Libraries/predicates.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Contadores por thread. Só a própria thread escreve neles, com load + store relaxados
+// (sem instrução atômica de leitura-modificação), e getPredicateStats os lê de qualquer
+// thread sem corrida. Cada thread se registra uma vez; ao terminar, soma seus valores
+// em 'retired'. resetPredicateStats não zera os contadores dos outros (a escrita
+// disputaria com a da dona): guarda o total atual em 'baseline', que é descontado.
+struct threadCounters;
+
+std::mutex countersMutex;
+std::vector<threadCounters*> liveCounters;
+predicateStats retired{0, 0};
+predicateStats baseline{0, 0};
+
+struct threadCounters{
+    std::atomic<unsigned long long> fast{0};
+    std::atomic<unsigned long long> exact{0};
+
+    threadCounters(){
+        std::lock_guard<std::mutex> lock(countersMutex);
+        liveCounters.push_back(this);
+    }
+
+    ~threadCounters(){
+        std::lock_guard<std::mutex> lock(countersMutex);
+        retired.fast += fast.load(std::memory_order_relaxed);
+        retired.exact += exact.load(std::memory_order_relaxed);
+        liveCounters.erase(std::find(liveCounters.begin(), liveCounters.end(), this));
+    }
+};
+
+threadCounters& localStats(){
+    thread_local threadCounters counters;
+    return counters;
+}
+
+inline void bump(std::atomic<unsigned long long>& counter){
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// Total desde o início do programa; chamar com countersMutex travado
+predicateStats totalStats(){
+    predicateStats total = retired;
+    for(const threadCounters* counters : liveCounters){
+        total.fast += counters->fast.load(std::memory_order_relaxed);
+        total.exact += counters->exact.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// epsilon = 2^-53 e limite de erro do filtro de orient2d (Shewchuk, "ccwerrboundA")
+const double epsilon = 1.1102230246251565e-16;
+const double ccwErrBound = (3.0 + 16.0 * epsilon) * epsilon;
+
+// Transformações sem erro: x + y representa exatamente o resultado.
+inline void twoSum(double a, double b, double& x, double& y){
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+inline void fastTwoSum(double a, double b, double& x, double& y){
+    // Requer |a| >= |b|
+    x = a + b;
+    y = b - (x - a);
+}
+
+inline void twoDiff(double a, double b, double& x, double& y){
+    x = a - b;
+    double bv = a - x;
+    double av = x + bv;
+    y = (a - av) + (bv - b);
+}
+
+inline void twoProduct(double a, double b, double& x, double& y){
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// Expansões: componentes não sobrepostas em ordem crescente de magnitude, zeros eliminados.
+int growExpansion(int elen, const double* e, double b, double* h){
+    double Q = b;
+    int hindex = 0;
+    for(int i = 0; i < elen; ++i){
+        double Qnew, hh;
+        twoSum(Q, e[i], Qnew, hh);
+        Q = Qnew;
+        if(hh != 0.0){
+            h[hindex++] = hh;
+        }
+    }
+    if(Q != 0.0 || hindex == 0){
+        h[hindex++] = Q;
+    }
+    return hindex;
+}
+
+int expansionSum(int elen, const double* e, int flen, const double* f, double* h){
+    int hlen = std::copy(e, e + elen, h) - h;
+    for(int i = 0; i < flen; ++i){
+        hlen = growExpansion(hlen, h, f[i], h);
+    }
+    return hlen;
+}
+
+int scaleExpansion(int elen, const double* e, double b, double* h){
+    double Q, hh;
+    int hindex = 0;
+    twoProduct(e[0], b, Q, hh);
+    if(hh != 0.0){
+        h[hindex++] = hh;
+    }
+    for(int i = 1; i < elen; ++i){
+        double product1, product0, sum;
+        twoProduct(e[i], b, product1, product0);
+        twoSum(Q, product0, sum, hh);
+        if(hh != 0.0){
+            h[hindex++] = hh;
+        }
+        fastTwoSum(product1, sum, Q, hh);
+        if(hh != 0.0){
+            h[hindex++] = hh;
+        }
+    }
+    if(Q != 0.0 || hindex == 0){
+        h[hindex++] = Q;
+    }
+    return hindex;
+}
+
+// Diferença a - b como expansão de até 2 componentes
+int diffExpansion(double a, double b, double* h){
+    double x, y;
+    twoDiff(a, b, x, y);
+    if(y == 0.0){
+        h[0] = x;
+        return 1;
+    }
+    h[0] = y;
+    h[1] = x;
+    return 2;
+}
+
+// Produto de duas expansões de até 2 componentes (no máximo 8 componentes)
+int productExpansion(int elen, const double* e, int flen, const double* f, double* h){
+    double t0[4], t1[4];
+    int len0 = scaleExpansion(elen, e, f[0], t0);
+    if(flen == 1){
+        std::copy(t0, t0 + len0, h);
+        return len0;
+    }
+    int len1 = scaleExpansion(elen, e, f[1], t1);
+    return expansionSum(len0, t0, len1, t1, h);
+}
+
+double orient2dExact(const ponto2D& a, const ponto2D& b, const ponto2D& c){
+    double acx[2], acy[2], bcx[2], bcy[2];
+    int acxLen = diffExpansion(a.x, c.x, acx);
+    int acyLen = diffExpansion(a.y, c.y, acy);
+    int bcxLen = diffExpansion(b.x, c.x, bcx);
+    int bcyLen = diffExpansion(b.y, c.y, bcy);
+
+    double left[8], right[8];
+    int leftLen = productExpansion(acxLen, acx, bcyLen, bcy, left);
+    int rightLen = productExpansion(acyLen, acy, bcxLen, bcx, right);
+    for(int i = 0; i < rightLen; ++i){
+        right[i] = -right[i];
+    }
+
+    double det[16];
+    int detLen = expansionSum(leftLen, left, rightLen, right, det);
+
+    // Componentes em ordem crescente de magnitude e sem sobreposição: somadas a partir
+    // da menor, dão o valor arredondado, com o sinal da mais significativa
+    double value = 0.0;
+    for(int i = 0; i < detLen; ++i){
+        value += det[i];
+    }
+    return value;
+}
+
+// orient2d com o valor (não só o sinal) preciso: o filtro só é aceito com folga de
+// 2^20 sobre o seu limite de erro, senão o determinante vem da expansão exata
+double orient2dValue(const ponto2D& a, const ponto2D& b, const ponto2D& c){
+    double detleft = (a.x - c.x) * (b.y - c.y);
+    double detright = (a.y - c.y) * (b.x - c.x);
+    double det = detleft - detright;
+    if(std::fabs(det) >= 0x1p20 * ccwErrBound * (std::fabs(detleft) + std::fabs(detright))){
+        return det;
+    }
+    return orient2dExact(a, b, c);
+}
+
+int sign(double v){
+    return (v > 0.0) - (v < 0.0);
+}
+
+// p está na caixa envolvente de ab (usado apenas quando a, b e p são colineares)
+bool onSegment(const ponto2D& a, const ponto2D& b, const ponto2D& p){
+    return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+           std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+}
+
+}
+
+double orient2d(const ponto2D& a, const ponto2D& b, const ponto2D& c){
+    threadCounters& stats = localStats();
+
+    double detleft = (a.x - c.x) * (b.y - c.y);
+    double detright = (a.y - c.y) * (b.x - c.x);
+    double det = detleft - detright;
+    double detsum;
+
+    if(detleft > 0.0){
+        if(detright <= 0.0){
+            bump(stats.fast);
+            return det;
+        }
+        detsum = detleft + detright;
+    }else if(detleft < 0.0){
+        if(detright >= 0.0){
+            bump(stats.fast);
+            return det;
+        }
+        detsum = -detleft - detright;
+    }else{
+        bump(stats.fast);
+        return det;
+    }
+
+    double errbound = ccwErrBound * detsum;
+    if(det >= errbound || -det >= errbound){
+        bump(stats.fast);
+        return det;
+    }
+
+    bump(stats.exact);
+    return orient2dExact(a, b, c);
+}
+
+bool segmentsIntersect(const ponto2D& a, const ponto2D& b, const ponto2D& c, const ponto2D& d){
+    int o1 = sign(orient2d(a, b, c));
+    int o2 = sign(orient2d(a, b, d));
+    int o3 = sign(orient2d(c, d, a));
+    int o4 = sign(orient2d(c, d, b));
+
+    // Cruzamento próprio
+    if(o1 * o2 < 0 && o3 * o4 < 0){
+        return true;
+    }
+
+    // Toques e sobreposições colineares
+    return (o1 == 0 && onSegment(a, b, c)) ||
+           (o2 == 0 && onSegment(a, b, d)) ||
+           (o3 == 0 && onSegment(c, d, a)) ||
+           (o4 == 0 && onSegment(c, d, b));
+}
+
+bool segmentIntersectionPoint(const ponto2D& a, const ponto2D& b, const ponto2D& c, const ponto2D& d, ponto2D& out){
+    int o1 = sign(orient2d(a, b, c));
+    int o2 = sign(orient2d(a, b, d));
+    int o3 = sign(orient2d(c, d, a));
+    int o4 = sign(orient2d(c, d, b));
+
+    if(o1 * o2 < 0 && o3 * o4 < 0){
+        // Cruzamento próprio: t vem das distâncias (com sinal) de a e b à reta cd, com
+        // os mesmos sinais exatos e opostos acima, então oa - ob nunca é zero, mesmo
+        // com as retas quase paralelas, quando o determinante em double arredonda para
+        // zero. Os valores precisos (não só os sinais) mantêm o ponto sobre cd.
+        double oa = orient2dValue(c, d, a);
+        double ob = orient2dValue(c, d, b);
+        double t = oa / (oa - ob);
+        t = std::clamp(t, 0.0, 1.0);
+        out = ponto2D(a.x + t * (b.x - a.x), a.y + t * (b.y - a.y));
+        return true;
+    }
+
+    if(o1 == 0 && onSegment(a, b, c)){ out = c; return true; }
+    if(o2 == 0 && onSegment(a, b, d)){ out = d; return true; }
+    if(o3 == 0 && onSegment(c, d, a)){ out = a; return true; }
+    if(o4 == 0 && onSegment(c, d, b)){ out = b; return true; }
+
+    return false;
+}
+
+predicateStats getPredicateStats(){
+    std::lock_guard<std::mutex> lock(countersMutex);
+    predicateStats total = totalStats();
+    return predicateStats{total.fast - baseline.fast, total.exact - baseline.exact};
+}
+
+void resetPredicateStats(){
+    std::lock_guard<std::mutex> lock(countersMutex);
+    baseline = totalStats();
+}
@@ -0,0 +1,174 @@
+#include "../Libraries/profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Amostras mantidas por escopo para os percentis
+const std::size_t windowSize = 240;
+
+// Escopos distintos acompanhados; nomes além disso são ignorados
+const std::size_t maxScopes = 64;
+
+// Eventos do trace guardados (cerca de 32 MB), num anel alocado uma vez quando o
+// profiler é ligado pela primeira vez: gravar nunca toca no heap, e com o anel cheio
+// os eventos mais antigos são sobrescritos.
+const std::size_t maxTraceEvents = 1 << 20;
+
+struct timerWindow{
+    const char* name;
+    float samples[windowSize]; // Milissegundos
+    std::size_t count;
+    std::size_t next;
+};
+
+struct traceEvent{
+    const char* name;
+    std::size_t thread;
+    long long startNs;
+    long long durationNs;
+};
+
+std::atomic<bool> enabled{false};
+std::mutex profileMutex;
+timerWindow windows[maxScopes];
+std::size_t windowCount = 0;
+std::vector<traceEvent> events;   // Anel: capacidade maxTraceEvents
+std::size_t eventNext = 0;
+std::size_t eventCount = 0;
+long long originNs = profileNow();
+
+// nullptr com a tabela cheia
+timerWindow* windowFor(const char* name){
+    for(std::size_t k = 0; k < windowCount; ++k){
+        if(windows[k].name == name){
+            return &windows[k];
+        }
+    }
+    if(windowCount == maxScopes){
+        return nullptr;
+    }
+    windows[windowCount] = timerWindow{name, {}, 0, 0};
+    return &windows[windowCount++];
+}
+
+double percentile(const float* sorted, std::size_t count, double p){
+    std::size_t index = std::min(count - 1, std::size_t(p * (count - 1) + 0.5));
+    return sorted[index];
+}
+
+}
+
+void setProfilingEnabled(bool value){
+    if(value){
+        std::lock_guard<std::mutex> lock(profileMutex);
+        if(events.empty()){
+            events.resize(maxTraceEvents);
+        }
+    }
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool profilingEnabled(){
+    return enabled.load(std::memory_order_relaxed);
+}
+
+long long profileNow(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void profileRecord(const char* name, long long startNs, long long endNs){
+    std::size_t thread = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+    std::lock_guard<std::mutex> lock(profileMutex);
+
+    if(timerWindow* window = windowFor(name)){
+        window->samples[window->next] = (endNs - startNs) * 1e-6f;
+        window->next = (window->next + 1) % windowSize;
+        window->count = std::min(window->count + 1, windowSize);
+    }
+
+    // Vazio só se o profiler nunca foi ligado (profileRecord chamado direto)
+    if(!events.empty()){
+        events[eventNext] = traceEvent{name, thread, startNs - originNs, endNs - startNs};
+        eventNext = (eventNext + 1) % maxTraceEvents;
+        eventCount = std::min(eventCount + 1, maxTraceEvents);
+    }
+}
+
+std::size_t profileSummary(timerSummary* out, std::size_t capacity){
+    std::lock_guard<std::mutex> lock(profileMutex);
+
+    std::size_t written = 0;
+    for(std::size_t w = 0; w < windowCount; ++w){
+        const timerWindow& window = windows[w];
+        if(written == capacity){
+            break;
+        }
+        if(window.count == 0){
+            continue;
+        }
+
+        float sorted[windowSize];
+        std::copy(window.samples, window.samples + window.count, sorted);
+        std::sort(sorted, sorted + window.count);
+
+        out[written++] = timerSummary{
+            window.name,
+            window.count,
+            percentile(sorted, window.count, 0.50),
+            percentile(sorted, window.count, 0.95),
+            percentile(sorted, window.count, 0.99)
+        };
+    }
+    return written;
+}
+
+void profileTitle(char* buffer, std::size_t size){
+    timerSummary summary[32];
+    std::size_t count = profileSummary(summary, 32);
+
+    std::size_t used = 0;
+    buffer[0] = '\0';
+    for(std::size_t k = 0; k < count && used < size; ++k){
+        int n = std::snprintf(buffer + used, size - used, "%s%s %.2f/%.2f", k ? " | " : "", summary[k].name, summary[k].p50, summary[k].p95);
+        if(n < 0){
+            break;
+        }
+        used += n;
+    }
+}
+
+bool writeChromeTrace(const char* path){
+    std::FILE* file = std::fopen(path, "w");
+    if(file == nullptr){
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(profileMutex);
+
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    // Do mais antigo ao mais recente
+    std::size_t first = (eventNext + maxTraceEvents - eventCount) % maxTraceEvents;
+    for(std::size_t k = 0; k < eventCount; ++k){
+        const traceEvent& e = events[(first + k) % maxTraceEvents];
+        // Chrome trace usa microssegundos
+        std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}",
+                     k ? ",\n" : "", e.name, e.thread % 100000, e.startNs * 1e-3, e.durationNs * 1e-3);
+    }
+    std::fprintf(file, "\n]}\n");
+
+    return std::fclose(file) == 0;
+}
+
+void resetProfile(){
+    std::lock_guard<std::mutex> lock(profileMutex);
+    windowCount = 0;
+    eventNext = 0;
+    eventCount = 0;
+}
@@ -0,0 +1,231 @@
+#include "../Libraries/quantized.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Mesma folga relativa de volumes.cpp, para o arredondamento do centro e do raio
+const double fitMargin = 1.0 + 1e-9;
+
+// Maior deslocamento de um ponto pela quantização: meio passo em cada eixo
+const double halfDiagonal = 0.7071067811865476;
+
+// Menor potência de 2 >= value (value > 0)
+double powerOfTwoAtLeast(double value){
+    int exponent;
+    double mantissa = std::frexp(value, &exponent);
+    return mantissa == 0.5 ? value : std::ldexp(1.0, exponent);
+}
+
+// Limites de um subconjunto não vazio
+void subsetBounds(const std::vector<ponto2D>& sub, ponto2D& lo, ponto2D& hi){
+    lo = hi = sub.front();
+    for(const auto& p : sub){
+        lo = minimum(lo, p);
+        hi = maximum(hi, p);
+    }
+}
+
+int sign(__int128 value){
+    return (value > 0) - (value < 0);
+}
+
+bool onSegment(const latticePoint& a, const latticePoint& b, const latticePoint& p){
+    return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+           std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+}
+
+}
+
+template<typename I>
+std::size_t quantizedCloud2D<I>::subsets() const{
+    return offsets.size() - 1;
+}
+
+template<typename I>
+std::size_t quantizedCloud2D<I>::points() const{
+    return x.size();
+}
+
+template<typename I>
+std::size_t quantizedCloud2D<I>::begin(std::size_t k) const{
+    return offsets[k];
+}
+
+template<typename I>
+std::size_t quantizedCloud2D<I>::end(std::size_t k) const{
+    return offsets[k + 1];
+}
+
+template<typename I>
+latticePoint quantizedCloud2D<I>::lattice(std::size_t k, std::size_t i) const{
+    return latticePoint{origin_x[k] + x[i], origin_y[k] + y[i]};
+}
+
+template<typename I>
+ponto2D quantizedCloud2D<I>::point(std::size_t k, std::size_t i) const{
+    latticePoint p = lattice(k, i);
+    return ponto2D(double(p.x) * step, double(p.y) * step);
+}
+
+template<typename I>
+std::size_t quantizedCloud2D<I>::bytes() const{
+    return (x.size() + y.size()) * sizeof(I) + (origin_x.size() + origin_y.size()) * sizeof(std::int64_t) +
+           offsets.size() * sizeof(std::size_t);
+}
+
+double quantizationStep(const std::vector<std::vector<ponto2D>>& cloud, int bits){
+    // Com origem = centro arredondado, |q| <= meia extensão / passo + 1
+    double range = double((std::int64_t(1) << (bits - 1)) - 1) - 1.0;
+
+    double need = 0.0;
+    for(const auto& sub : cloud){
+        if(sub.empty()){
+            continue;
+        }
+        ponto2D lo, hi;
+        subsetBounds(sub, lo, hi);
+        double half = 0.5 * std::max(hi.x - lo.x, hi.y - lo.y);
+        double magnitude = std::max({std::fabs(lo.x), std::fabs(lo.y), std::fabs(hi.x), std::fabs(hi.y)});
+        need = std::max({need, half / range, std::ldexp(magnitude, -52)});
+    }
+    return need > 0.0 ? powerOfTwoAtLeast(need) : 1.0;
+}
+
+template<typename I>
+void quantizeCloud(const std::vector<std::vector<ponto2D>>& cloud, quantizedCloud2D<I>& out){
+    out.step = quantizationStep(cloud, 8 * sizeof(I));
+    out.x.clear();
+    out.y.clear();
+    out.origin_x.clear();
+    out.origin_y.clear();
+    out.offsets.assign(1, 0);
+
+    // Passo potência de 2: p / step é exato, e só o arredondamento para inteiro erra
+    double inverse = 1.0 / out.step;
+    for(const auto& sub : cloud){
+        std::int64_t ox = 0, oy = 0;
+        if(!sub.empty()){
+            ponto2D lo, hi;
+            subsetBounds(sub, lo, hi);
+            ox = std::llround(0.5 * (lo.x + hi.x) * inverse);
+            oy = std::llround(0.5 * (lo.y + hi.y) * inverse);
+        }
+        out.origin_x.push_back(ox);
+        out.origin_y.push_back(oy);
+
+        for(const auto& p : sub){
+            out.x.push_back(I(std::llround(p.x * inverse) - ox));
+            out.y.push_back(I(std::llround(p.y * inverse) - oy));
+        }
+        out.offsets.push_back(out.x.size());
+    }
+}
+
+template<typename I>
+aabb2D quantizedAABB(const quantizedCloud2D<I>& cloud, std::size_t k){
+    std::size_t first = cloud.begin(k), last = cloud.end(k);
+    if(first == last){
+        // Como calculateAABB: caixa vazia, que não contém nada
+        double inf = std::numeric_limits<double>::infinity();
+        return aabb2D{inf, inf, -inf, -inf};
+    }
+
+    const I* __restrict x = cloud.x.data();
+    const I* __restrict y = cloud.y.data();
+    I min_x = x[first], min_y = y[first], max_x = x[first], max_y = y[first];
+    for(std::size_t i = first; i < last; ++i){
+        min_x = std::min(min_x, x[i]);
+        min_y = std::min(min_y, y[i]);
+        max_x = std::max(max_x, x[i]);
+        max_y = std::max(max_y, y[i]);
+    }
+
+    // (n -+ 1/2) * step = (2n -+ 1) * (step / 2): exato em double
+    double half = 0.5 * cloud.step;
+    std::int64_t ox = cloud.origin_x[k], oy = cloud.origin_y[k];
+    return aabb2D{double(2 * (ox + min_x) - 1) * half, double(2 * (oy + min_y) - 1) * half,
+                  double(2 * (ox + max_x) + 1) * half, double(2 * (oy + max_y) + 1) * half};
+}
+
+template<typename I>
+circle2D quantizedCircle(const quantizedCloud2D<I>& cloud, std::size_t k){
+    std::size_t first = cloud.begin(k), last = cloud.end(k);
+    if(first == last){
+        return circle2D(ponto2D(0.0, 0.0), 0.0);
+    }
+
+    const I* __restrict x = cloud.x.data();
+    const I* __restrict y = cloud.y.data();
+
+    // Centróide em passos, relativo à origem: somas inteiras, sem erro
+    std::int64_t sum_x = 0, sum_y = 0;
+    for(std::size_t i = first; i < last; ++i){
+        sum_x += x[i];
+        sum_y += y[i];
+    }
+    double cx = double(sum_x) / (last - first), cy = double(sum_y) / (last - first);
+
+    double radius2 = 0.0;
+    for(std::size_t i = first; i < last; ++i){
+        double dx = x[i] - cx, dy = y[i] - cy;
+        radius2 = std::max(radius2, dx * dx + dy * dy);
+    }
+
+    ponto2D center((double(cloud.origin_x[k]) + cx) * cloud.step, (double(cloud.origin_y[k]) + cy) * cloud.step);
+    return circle2D(center, (std::sqrt(radius2) + halfDiagonal) * cloud.step * fitMargin);
+}
+
+template<typename I>
+void quantizedAABBs(const quantizedCloud2D<I>& cloud, std::vector<aabb2D>& out, threadPool* pool){
+    out.resize(cloud.subsets());
+    forEachIndex(pool, cloud.subsets(), [&](std::size_t k){
+        out[k] = quantizedAABB(cloud, k);
+    });
+}
+
+template<typename I>
+void quantizedCircles(const quantizedCloud2D<I>& cloud, std::vector<circle2D>& out, threadPool* pool){
+    out.resize(cloud.subsets());
+    forEachIndex(pool, cloud.subsets(), [&](std::size_t k){
+        out[k] = quantizedCircle(cloud, k);
+    });
+}
+
+int orientLattice(const latticePoint& a, const latticePoint& b, const latticePoint& c){
+    __int128 detleft = __int128(a.x - c.x) * (b.y - c.y);
+    __int128 detright = __int128(a.y - c.y) * (b.x - c.x);
+    return sign(detleft - detright);
+}
+
+bool segmentsIntersectLattice(const latticePoint& a, const latticePoint& b, const latticePoint& c, const latticePoint& d){
+    int o1 = orientLattice(a, b, c);
+    int o2 = orientLattice(a, b, d);
+    int o3 = orientLattice(c, d, a);
+    int o4 = orientLattice(c, d, b);
+
+    // Cruzamento próprio
+    if(o1 * o2 < 0 && o3 * o4 < 0){
+        return true;
+    }
+
+    // Toques e sobreposições colineares
+    return (o1 == 0 && onSegment(a, b, c)) ||
+           (o2 == 0 && onSegment(a, b, d)) ||
+           (o3 == 0 && onSegment(c, d, a)) ||
+           (o4 == 0 && onSegment(c, d, b));
+}
+
+template struct quantizedCloud2D<std::int16_t>;
+template struct quantizedCloud2D<std::int32_t>;
+template void quantizeCloud(const std::vector<std::vector<ponto2D>>&, quantized16&);
+template void quantizeCloud(const std::vector<std::vector<ponto2D>>&, quantized32&);
+template aabb2D quantizedAABB(const quantized16&, std::size_t);
+template aabb2D quantizedAABB(const quantized32&, std::size_t);
+template circle2D quantizedCircle(const quantized16&, std::size_t);
+template circle2D quantizedCircle(const quantized32&, std::size_t);
+template void quantizedAABBs(const quantized16&, std::vector<aabb2D>&, threadPool*);
+template void quantizedAABBs(const quantized32&, std::vector<aabb2D>&, threadPool*);
+template void quantizedCircles(const quantized16&, std::vector<circle2D>&, threadPool*);
+template void quantizedCircles(const quantized32&, std::vector<circle2D>&, threadPool*);
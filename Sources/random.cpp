@@ -0,0 +1,62 @@
+#include "../Libraries/random.h"
+#include <atomic>
+
+namespace {
+
+std::uint64_t splitmix64(std::uint64_t& x){
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+std::atomic<std::uint64_t> sessionSeed{0};
+std::atomic<unsigned> generation{1};   // Muda a cada seedRandom
+std::atomic<std::uint64_t> nextThread{0};
+
+struct threadEngine{
+    xoshiro256ss engine;
+    unsigned generation = 0;
+    std::uint64_t index = nextThread.fetch_add(1, std::memory_order_relaxed);
+};
+
+}
+
+xoshiro256ss::xoshiro256ss(std::uint64_t seed){
+    this->seed(seed);
+}
+
+void xoshiro256ss::seed(std::uint64_t seed){
+    for(auto& word : s){
+        word = splitmix64(seed);
+    }
+}
+
+void seedRandom(std::uint64_t seed){
+    sessionSeed.store(seed, std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
+    threadRandom(); // Garante o índice 0 para a thread que semeia
+}
+
+std::uint64_t randomSeed(){
+    return sessionSeed.load(std::memory_order_relaxed);
+}
+
+xoshiro256ss& threadRandom(){
+    thread_local threadEngine local;
+
+    unsigned current = generation.load(std::memory_order_acquire);
+    if(local.generation != current){
+        local.engine = randomStream(randomSeed(), local.index);
+        local.generation = current;
+    }
+    return local.engine;
+}
+
+xoshiro256ss randomStream(std::uint64_t seed, std::uint64_t stream){
+    // Mistura (semente, fluxo) em uma semente de 64 bits; splitmix64 espalha
+    // sementes vizinhas por todo o espaço de estados
+    std::uint64_t x = seed;
+    std::uint64_t mixed = splitmix64(x) ^ (stream * 0xD1B54A32D192ED03ull);
+    return xoshiro256ss(splitmix64(mixed));
+}
@@ -0,0 +1,157 @@
+#include "../Libraries/render.h"
+#include "glm/gtc/type_ptr.hpp"
+#include <algorithm>
+#include <cstring>
+
+renderer::renderer(): vao{0}, vbo{0}, vboCapacity{0}, matricesUBO{0}, projection{}, hasProjection{false},
+                      boundProgram{-1}, stats{0, 0, 0, 0} {}
+
+void renderer::init(){
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(colorVertex), (void*)offsetof(colorVertex, x));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(colorVertex), (void*)offsetof(colorVertex, r));
+    glEnableVertexAttribArray(1);
+
+    // Uniform block "Matrices" no ponto de ligação 0
+    glGenBuffers(1, &matricesUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, 0, matricesUBO);
+
+    glPointSize(7.0f);
+}
+
+int renderer::addProgram(unsigned int program){
+    unsigned int block = glGetUniformBlockIndex(program, "Matrices");
+    if(block != GL_INVALID_INDEX){
+        glUniformBlockBinding(program, block, 0);
+    }
+
+    programs.push_back(program);
+    return programs.size() - 1;
+}
+
+void renderer::setProjection(const glm::mat4& matrix){
+    if(hasProjection && std::memcmp(&projection, &matrix, sizeof(glm::mat4)) == 0){
+        stats.skippedBinds++;
+        return;
+    }
+
+    projection = matrix;
+    hasProjection = true;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(projection));
+    stats.glCalls += 2;
+}
+
+void renderer::submit(int layer, GLenum mode, const float* xyz, std::size_t count, float red, float green, float blue, int program){
+    if(count == 0){
+        return;
+    }
+
+    commands.push_back(drawCommand{layer, program, mode, GLint(vertices.size()), GLsizei(count)});
+    for(std::size_t k = 0; k < count; ++k){
+        vertices.push_back(colorVertex{xyz[3 * k], xyz[3 * k + 1], xyz[3 * k + 2], red, green, blue});
+    }
+}
+
+void renderer::submit(int layer, GLenum mode, const colorVertex* data, std::size_t count, int program){
+    if(count == 0){
+        return;
+    }
+
+    commands.push_back(drawCommand{layer, program, mode, GLint(vertices.size()), GLsizei(count)});
+    vertices.insert(vertices.end(), data, data + count);
+}
+
+void renderer::useProgram(int program){
+    if(boundProgram == program){
+        stats.skippedBinds++;
+        return;
+    }
+    glUseProgram(programs[program]);
+    boundProgram = program;
+    stats.glCalls++;
+    stats.stateChanges++;
+}
+
+void renderer::flush(){
+    if(commands.empty()){
+        return;
+    }
+
+    std::stable_sort(commands.begin(), commands.end(), [](const drawCommand& a, const drawCommand& b){
+        if(a.layer != b.layer) return a.layer < b.layer;
+        if(a.program != b.program) return a.program < b.program;
+        return a.mode < b.mode;
+    });
+
+    // Copia os vértices na ordem de desenho: cada grupo fica contíguo no VBO
+    sorted.clear();
+    for(drawCommand& command : commands){
+        GLint first = sorted.size();
+        sorted.insert(sorted.end(), vertices.begin() + command.first, vertices.begin() + command.first + command.count);
+        command.first = first;
+    }
+
+    // Um único upload para todos os vértices do quadro; o buffer só cresce
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    std::size_t bytes = sorted.size() * sizeof(colorVertex);
+    if(bytes > vboCapacity){
+        vboCapacity = std::max(bytes, 2 * vboCapacity);
+        glBufferData(GL_ARRAY_BUFFER, vboCapacity, nullptr, GL_STREAM_DRAW);
+        stats.glCalls++;
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, sorted.data());
+    stats.glCalls += 3;
+
+    for(std::size_t k = 0; k < commands.size();){
+        const drawCommand& head = commands[k];
+
+        firsts.clear();
+        counts.clear();
+        std::size_t end = k;
+        GLsizei total = 0;
+        while(end < commands.size() &&
+              commands[end].layer == head.layer &&
+              commands[end].program == head.program &&
+              commands[end].mode == head.mode){
+            firsts.push_back(commands[end].first);
+            counts.push_back(commands[end].count);
+            total += commands[end].count;
+            end++;
+        }
+
+        useProgram(head.program);
+
+        if(head.mode == GL_POINTS || head.mode == GL_LINES || head.mode == GL_TRIANGLES){
+            // Primitivas independentes: o grupo contíguo vira um único desenho
+            glDrawArrays(head.mode, head.first, total);
+        }else{
+            // Laços e faixas precisam de uma primitiva por comando
+            glMultiDrawArrays(head.mode, firsts.data(), counts.data(), firsts.size());
+        }
+        stats.glCalls++;
+        stats.drawCalls++;
+
+        k = end;
+    }
+
+    commands.clear();
+    vertices.clear();
+}
+
+void renderer::beginFrame(){
+    stats = renderStats{0, 0, 0, 0};
+}
+
+renderStats renderer::frameStats() const{
+    return stats;
+}
@@ -0,0 +1,97 @@
+#include "../Libraries/replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+bool loadInputScript(const char* path, inputScript& script){
+    std::ifstream file(path);
+    if(!file){
+        std::cerr << "Nao foi possivel abrir o roteiro " << path << std::endl;
+        return false;
+    }
+
+    script.seed = 0;
+    script.events.clear();
+
+    std::string line;
+    int number = 0;
+    while(std::getline(file, line)){
+        number++;
+        if(line.empty() || line[0] == '#'){
+            continue;
+        }
+
+        std::istringstream in(line);
+        std::string kind;
+        in >> kind;
+
+        inputEvent e{0.0, EVENT_KEY, 0, 0.0, 0.0};
+        if(kind == "seed"){
+            in >> script.seed;
+        }else if(kind == "key"){
+            in >> e.time >> e.key;
+            script.events.push_back(e);
+        }else if(kind == "click"){
+            e.type = EVENT_CLICK;
+            in >> e.time >> e.x >> e.y;
+            script.events.push_back(e);
+        }else{
+            std::cerr << path << ":" << number << ": evento desconhecido '" << kind << "'" << std::endl;
+            return false;
+        }
+
+        if(in.fail()){
+            std::cerr << path << ":" << number << ": linha malformada" << std::endl;
+            return false;
+        }
+    }
+
+    std::stable_sort(script.events.begin(), script.events.end(), [](const inputEvent& a, const inputEvent& b){
+        return a.time < b.time;
+    });
+    return true;
+}
+
+bool saveInputScript(const char* path, const inputScript& script){
+    std::ofstream file(path);
+    if(!file){
+        std::cerr << "Nao foi possivel gravar o roteiro " << path << std::endl;
+        return false;
+    }
+
+    // Precisão total: o mesmo clique precisa cair no mesmo ponto ao reproduzir
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    file << "# BoundingVolume replay v1\n";
+    file << "seed " << script.seed << "\n";
+    for(const inputEvent& e : script.events){
+        if(e.type == EVENT_KEY){
+            file << "key " << e.time << " " << e.key << "\n";
+        }else{
+            file << "click " << e.time << " " << e.x << " " << e.y << "\n";
+        }
+    }
+    return bool(file);
+}
+
+inputPlayer::inputPlayer(const inputScript& script): script{&script}, next{0} {}
+
+std::size_t inputPlayer::dispatchUntil(double now, const std::function<void(const inputEvent&)>& handler){
+    std::size_t delivered = 0;
+    while(next < script->events.size() && script->events[next].time <= now){
+        handler(script->events[next++]);
+        delivered++;
+    }
+    return delivered;
+}
+
+bool inputPlayer::finished() const{
+    return next == script->events.size();
+}
+
+double inputPlayer::lastEventTime() const{
+    return script->events.empty() ? 0.0 : script->events.back().time;
+}
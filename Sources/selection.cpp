@@ -0,0 +1,187 @@
+#include "../Libraries/selection.h"
+#include "../Libraries/hull.h"
+#include "../Libraries/collision.h"
+#include "../Libraries/profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Subconjuntos usados na calibração (~80 mil pares por tipo) e repetições por tipo
+const std::size_t calibrationSubsets = 400;
+const int calibrationRuns = 3;
+
+// Área de um polígono (fórmula do laço)
+double polygonArea(const std::vector<ponto2D>& polygon){
+    double twice = 0.0;
+    for(std::size_t k = 0; k < polygon.size(); ++k){
+        const ponto2D& a = polygon[k];
+        const ponto2D& b = polygon[(k + 1) % polygon.size()];
+        twice += a.x * b.y - a.y * b.x;
+    }
+    return 0.5 * std::fabs(twice);
+}
+
+taggedVolume boundingBox(const std::vector<ponto2D>& points){
+    aabb2D box{std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+               -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    for(const auto& p : points){
+        box.min_x = std::min(box.min_x, p.x);
+        box.min_y = std::min(box.min_y, p.y);
+        box.max_x = std::max(box.max_x, p.x);
+        box.max_y = std::max(box.max_y, p.y);
+    }
+    return makeVolume(box);
+}
+
+// Mesmo círculo da tecla C: centro no centróide, raio até o ponto mais distante
+taggedVolume centroidCircle(const std::vector<ponto2D>& points){
+    ponto2D centroid;
+    for(const auto& p : points){
+        centroid = centroid + p;
+    }
+    centroid = centroid * (1.0 / points.size());
+
+    double radius = 0.0;
+    for(const auto& p : points){
+        ponto2D d = p - centroid;
+        radius = std::max(radius, length(d));
+    }
+    return makeVolume(circle2D(centroid, radius));
+}
+
+// OBB alinhada ao eixo da cápsula (eixo principal)
+taggedVolume principalOBB(const std::vector<ponto2D>& points, const ponto2D& U){
+    ponto2D V(-U.y, U.x);
+    double min_u = std::numeric_limits<double>::infinity(), max_u = -min_u;
+    double min_v = min_u, max_v = -min_u;
+    for(const auto& p : points){
+        double u = dot(p, U);
+        double v = dot(p, V);
+        min_u = std::min(min_u, u);
+        max_u = std::max(max_u, u);
+        min_v = std::min(min_v, v);
+        max_v = std::max(max_v, v);
+    }
+    double cu = 0.5 * (min_u + max_u);
+    double cv = 0.5 * (min_v + max_v);
+    return makeVolume(obb2D(U * cu + V * cv, ponto2D(0.5 * (max_u - min_u), 0.5 * (max_v - min_v)), U, V));
+}
+
+}
+
+volumeCostModel defaultCostModel(){
+    return volumeCostModel{{1.0, 0.84, 3.3, 5.3, 96.0}, 1.6};
+}
+
+volumeCostModel calibrateCostModel(const std::vector<std::vector<ponto2D>>& cloud, double maxLooseness){
+    // Os cinco candidatos de cada subconjunto, separados por tipo
+    std::vector<taggedVolume> volumes[VOLUME_KINDS];
+    for(const auto& sub : cloud){
+        if(volumes[0].size() == calibrationSubsets){
+            break;
+        }
+        if(sub.empty()){
+            continue;
+        }
+        volumeChoice choice = chooseVolume(sub, defaultCostModel());
+        for(int k = 0; k < VOLUME_KINDS; ++k){
+            volumes[k].push_back(choice.candidates[k]);
+        }
+    }
+
+    volumeCostModel model = defaultCostModel();
+    model.maxLooseness = maxLooseness;
+    if(volumes[0].size() < 2){
+        return model;
+    }
+
+    // Melhor de algumas execuções seriais de intersectVolumes, por par
+    contactBuffer contacts;
+    double perPair[VOLUME_KINDS];
+    double pairs = 0.5 * double(volumes[0].size()) * double(volumes[0].size() - 1);
+    for(int k = 0; k < VOLUME_KINDS; ++k){
+        long long best = -1;
+        for(int run = 0; run < calibrationRuns; ++run){
+            long long start = profileNow();
+            intersectVolumes(volumes[k], contacts);
+            long long elapsed = profileNow() - start;
+            best = best < 0 ? elapsed : std::min(best, elapsed);
+        }
+        perPair[k] = std::max(1.0, double(best)) / pairs;
+    }
+
+    for(int k = 0; k < VOLUME_KINDS; ++k){
+        model.testCost[k] = perPair[k] / perPair[VOLUME_AABB];
+    }
+    return model;
+}
+
+volumeChoice chooseVolume(const std::vector<ponto2D>& points, const volumeCostModel& model){
+    volumeChoice choice;
+    if(points.empty()){
+        for(auto& candidate : choice.candidates){
+            candidate = taggedVolume{ponto2D(), ponto2D(1.0, 0.0), 0.0, 0.0, VOLUME_AABB};
+        }
+        std::fill(choice.looseness, choice.looseness + VOLUME_KINDS, 1.0);
+        choice.chosen = VOLUME_AABB;
+        return choice;
+    }
+
+    taggedVolume capsule = makeVolume(fitCapsule(points));
+
+    choice.candidates[VOLUME_AABB] = boundingBox(points);
+    choice.candidates[VOLUME_CIRCLE] = centroidCircle(points);
+    choice.candidates[VOLUME_OBB] = principalOBB(points, capsule.U);
+    choice.candidates[VOLUME_CAPSULE] = capsule;
+    choice.candidates[VOLUME_ELLIPSE] = makeVolume(fitEllipse(points));
+
+    // A conversão para centro + meias dimensões arredonda: sem a folga os pontos da
+    // borda podem cair fora
+    for(auto& candidate : choice.candidates){
+        candidate.e0 = candidate.e0 * (1.0 + 1e-9) + 1e-12;
+        candidate.e1 = candidate.e1 * (1.0 + 1e-9) + 1e-12;
+    }
+
+    // Fecho degenerado (pontos colineares) tem área zero: a razão fica infinita e
+    // vence o candidato de menor área
+    double hullArea = polygonArea(convexHull(points));
+
+    double area[VOLUME_KINDS];
+    int tightest = 0;
+    int best = -1;
+    for(int k = 0; k < VOLUME_KINDS; ++k){
+        area[k] = volumeArea(choice.candidates[k]);
+        choice.looseness[k] = hullArea > 0.0 ? area[k] / hullArea : std::numeric_limits<double>::infinity();
+
+        if(area[k] < area[tightest]){
+            tightest = k;
+        }
+        if(choice.looseness[k] <= model.maxLooseness && (best < 0 || model.testCost[k] < model.testCost[best])){
+            best = k;
+        }
+    }
+
+    choice.chosen = best >= 0 ? best : tightest;
+    return choice;
+}
+
+void selectVolumes(const std::vector<std::vector<ponto2D>>& cloud, std::vector<taggedVolume>& volumes, const volumeCostModel& model,
+                   threadPool* pool, std::size_t histogram[VOLUME_KINDS]){
+    volumes.resize(cloud.size());
+
+    auto select = [&](std::size_t k){
+        volumeChoice choice = chooseVolume(cloud[k], model);
+        volumes[k] = choice.candidates[choice.chosen];
+    };
+
+    forEachIndex(pool, cloud.size(), select);
+
+    if(histogram != nullptr){
+        std::fill(histogram, histogram + VOLUME_KINDS, 0);
+        for(const auto& v : volumes){
+            histogram[v.kind]++;
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#include "../Libraries/taskgraph.h"
+#include "../Libraries/profiler.h"
+#include <thread>
+
+namespace {
+
+const std::size_t noTask = ~std::size_t(0);
+
+}
+
+std::size_t taskGraph::add(const char* name, std::function<void()> fn, std::initializer_list<std::size_t> dependencies){
+    std::size_t index = count++;
+    if(index == tasks.size()){
+        tasks.emplace_back();
+    }
+
+    task& t = tasks[index];
+    t.name = name;
+    t.fn = std::move(fn);
+    t.dependents.clear();
+    t.dependencies = 0;
+    t.timing = taskTiming{name, 0, 0, 0};
+
+    for(std::size_t d : dependencies){
+        depend(index, d);
+    }
+    return index;
+}
+
+void taskGraph::depend(std::size_t index, std::size_t on){
+    if(on < index && index < count){
+        tasks[on].dependents.push_back(index);
+        tasks[index].dependencies++;
+    }
+}
+
+void taskGraph::clear(){
+    count = 0;
+}
+
+std::size_t taskGraph::size() const{
+    return count;
+}
+
+void taskGraph::execute(std::size_t index){
+    std::size_t thread = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+    while(index != noTask){
+        task& t = tasks[index];
+        t.timing.thread = thread;
+        t.timing.startNs = profileNow();
+        t.fn();
+        t.timing.endNs = profileNow();
+        if(profilingEnabled()){
+            profileRecord(t.name, t.timing.startNs, t.timing.endNs);
+        }
+
+        // Segue com a primeira dependente que ficou pronta; as outras vão para o pool
+        std::size_t next = noTask;
+        for(std::size_t d : t.dependents){
+            if(tasks[d].pending.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                if(next == noTask){
+                    next = d;
+                }else{
+                    pool->submit([this, d]{ execute(d); });
+                }
+            }
+        }
+
+        // A última avisa com o mutex travado: run() só vê 'done' depois que ele é
+        // liberado, então não retorna (e o grafo não some) enquanto esta thread ainda
+        // usa 'mutex' ou 'finished'. Depois disso não toca mais em 'this'.
+        if(remaining.fetch_sub(1, std::memory_order_acq_rel) == 1){
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+            finished.notify_all();
+        }
+        index = next;
+    }
+}
+
+void taskGraph::run(threadPool& workers){
+    if(count == 0){
+        lastRunNs = 0;
+        return;
+    }
+
+    long long start = profileNow();
+    pool = &workers;
+    done = false;
+    remaining.store(count, std::memory_order_relaxed);
+    for(std::size_t k = 0; k < count; ++k){
+        tasks[k].pending.store(tasks[k].dependencies, std::memory_order_relaxed);
+    }
+
+    std::size_t first = noTask;
+    for(std::size_t k = 0; k < count; ++k){
+        if(tasks[k].dependencies != 0){
+            continue;
+        }
+        if(first == noTask){
+            first = k;
+        }else{
+            pool->submit([this, k]{ execute(k); });
+        }
+    }
+    execute(first);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]{ return done; });
+    lastRunNs = profileNow() - start;
+}
+
+const taskTiming& taskGraph::timing(std::size_t index) const{
+    return tasks[index].timing;
+}
+
+double taskGraph::lastRunMs() const{
+    return lastRunNs * 1e-6;
+}
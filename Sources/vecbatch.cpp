@@ -0,0 +1,170 @@
+#include "../Libraries/vecbatch.h"
+#include <cmath>
+
+// Compilado com -fno-math-errno (ver makefile): sem errno a raiz quadrada é vetorizada.
+// Em x86 o target_clones gera uma versão AVX-512 e uma AVX2 além da padrão (a das
+// flags do build); nas outras arquiteturas fica só a padrão.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATCH_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define BATCH_CLONES
+#endif
+
+namespace {
+
+// Os laços ficam em funções com parâmetros __restrict: o GCC só aproveita o
+// __restrict de parâmetros (inclusive depois de expandir a função inline), e sem ele
+// precisaria de mais testes de sobreposição do que aceita para vetorizar.
+
+template<typename Op>
+inline void map3Copy(const double* __restrict ax, const double* __restrict ay, const double* __restrict az,
+                     double* __restrict ox, double* __restrict oy, double* __restrict oz, std::size_t n, Op op){
+    for(std::size_t i = 0; i < n; ++i){
+        op(i, ax[i], ay[i], az[i], ox[i], oy[i], oz[i]);
+    }
+}
+
+template<typename Op>
+inline void map3InPlace(double* __restrict x, double* __restrict y, double* __restrict z, std::size_t n, Op op){
+    for(std::size_t i = 0; i < n; ++i){
+        double ox, oy, oz;
+        op(i, x[i], y[i], z[i], ox, oy, oz);
+        x[i] = ox;
+        y[i] = oy;
+        z[i] = oz;
+    }
+}
+
+// Aplica op(i, x, y, z, ox, oy, oz) a cada vetor i. A saída pode ser a própria
+// entrada; esse caso tem um laço próprio.
+template<typename Op>
+inline void map3(const vec3View& a, const vec3Span& out, Op op){
+    if(out.x == a.x && out.y == a.y && out.z == a.z){
+        map3InPlace(out.x, out.y, out.z, a.n, op);
+    }else{
+        map3Copy(a.x, a.y, a.z, out.x, out.y, out.z, a.n, op);
+    }
+}
+
+// Reduz cada vetor a um número
+template<typename Op>
+inline void reduce3(const double* __restrict ax, const double* __restrict ay, const double* __restrict az,
+                    double* __restrict out, std::size_t n, Op op){
+    for(std::size_t i = 0; i < n; ++i){
+        out[i] = op(ax[i], ay[i], az[i]);
+    }
+}
+
+inline void dotLoop(const double* __restrict ax, const double* __restrict ay, const double* __restrict az,
+                    const double* __restrict bx, const double* __restrict by, const double* __restrict bz,
+                    double* __restrict out, std::size_t n){
+    for(std::size_t i = 0; i < n; ++i){
+        out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+    }
+}
+
+// Operação de map3 para a x b_i. b não pode ser a saída.
+struct crossWith{
+    const double* __restrict bx;
+    const double* __restrict by;
+    const double* __restrict bz;
+
+    void operator()(std::size_t i, double x, double y, double z, double& ox, double& oy, double& oz) const{
+        ox = y * bz[i] - z * by[i];
+        oy = z * bx[i] - x * bz[i];
+        oz = x * by[i] - y * bx[i];
+    }
+};
+
+// A transformação tem coeficientes demais para caber no lambda de map3 sem que o GCC
+// desista de vetorizar; fica em laços próprios.
+struct affine3{
+    double m00, m01, m02, m10, m11, m12, m20, m21, m22, tx, ty, tz;
+
+    affine3(const vec3 rows[3], const vec3& t):
+        m00{rows[0].x}, m01{rows[0].y}, m02{rows[0].z},
+        m10{rows[1].x}, m11{rows[1].y}, m12{rows[1].z},
+        m20{rows[2].x}, m21{rows[2].y}, m22{rows[2].z},
+        tx{t.x}, ty{t.y}, tz{t.z} {}
+};
+
+inline void transformCopy(const double* __restrict ax, const double* __restrict ay, const double* __restrict az,
+                          double* __restrict ox, double* __restrict oy, double* __restrict oz, std::size_t n, affine3 m){
+    for(std::size_t i = 0; i < n; ++i){
+        double x = ax[i], y = ay[i], z = az[i];
+        ox[i] = m.m00 * x + m.m01 * y + m.m02 * z + m.tx;
+        oy[i] = m.m10 * x + m.m11 * y + m.m12 * z + m.ty;
+        oz[i] = m.m20 * x + m.m21 * y + m.m22 * z + m.tz;
+    }
+}
+
+inline void transformInPlace(double* __restrict px, double* __restrict py, double* __restrict pz, std::size_t n, affine3 m){
+    for(std::size_t i = 0; i < n; ++i){
+        double x = px[i], y = py[i], z = pz[i];
+        px[i] = m.m00 * x + m.m01 * y + m.m02 * z + m.tx;
+        py[i] = m.m10 * x + m.m11 * y + m.m12 * z + m.ty;
+        pz[i] = m.m20 * x + m.m21 * y + m.m22 * z + m.tz;
+    }
+}
+}
+
+BATCH_CLONES
+void batchDot(const vec3View& a, const vec3View& b, double* out){
+    dotLoop(a.x, a.y, a.z, b.x, b.y, b.z, out, a.n);
+}
+
+BATCH_CLONES
+void batchCross(const vec3View& a, const vec3View& b, const vec3Span& out){
+    map3(a, out, crossWith{b.x, b.y, b.z});
+}
+
+BATCH_CLONES
+void batchNorm(const vec3View& a, double* out){
+    reduce3(a.x, a.y, a.z, out, a.n, [](double x, double y, double z){
+        return std::sqrt(x * x + y * y + z * z);
+    });
+}
+
+BATCH_CLONES
+void batchNormalize(const vec3View& a, const vec3Span& out){
+    map3(a, out, [](std::size_t, double x, double y, double z, double& ox, double& oy, double& oz){
+        double inv = 1.0 / std::sqrt(x * x + y * y + z * z);
+        ox = x * inv;
+        oy = y * inv;
+        oz = z * inv;
+    });
+}
+
+BATCH_CLONES
+void batchProjection(const vec3View& a, const vec3& onto, const vec3Span& out){
+    double inv = 1.0 / onto.dot(onto);
+    double vx = onto.x, vy = onto.y, vz = onto.z;
+    map3(a, out, [=](std::size_t, double x, double y, double z, double& ox, double& oy, double& oz){
+        double l = (x * vx + y * vy + z * vz) * inv;
+        ox = vx * l;
+        oy = vy * l;
+        oz = vz * l;
+    });
+}
+
+BATCH_CLONES
+void batchReflect(const vec3View& a, const vec3& normal, const vec3Span& out){
+    double scale = 2.0 / normal.dot(normal);
+    double nx = normal.x, ny = normal.y, nz = normal.z;
+    map3(a, out, [=](std::size_t, double x, double y, double z, double& ox, double& oy, double& oz){
+        double l = (x * nx + y * ny + z * nz) * scale;
+        ox = x - nx * l;
+        oy = y - ny * l;
+        oz = z - nz * l;
+    });
+}
+
+BATCH_CLONES
+void batchTransform(const vec3View& a, const vec3 rows[3], const vec3& translation, const vec3Span& out){
+    if(out.x == a.x && out.y == a.y && out.z == a.z){
+        transformInPlace(out.x, out.y, out.z, a.n, affine3(rows, translation));
+    }else{
+        transformCopy(a.x, a.y, a.z, out.x, out.y, out.z, a.n, affine3(rows, translation));
+    }
+}
@@ -0,0 +1,877 @@
+#include "../Libraries/volumes.h"
+#include "../Libraries/hull.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace {
+
+// Folga relativa de círculo e OBB por precisão, como tolerance3 em volumes3d.cpp
+template<typename T>
+struct tolerance2;
+
+template<>
+struct tolerance2<double>{
+    static constexpr double slack = 1e-9;
+};
+
+template<>
+struct tolerance2<float>{
+    // ~64 u: cobre o erro de d · eixo em float para pontos a |c| da origem
+    static constexpr float slack = 8e-6f;
+};
+
+// Meia dimensão de [lo, hi] com folga também para a distância 'reach' à origem,
+// onde o arredondamento de p - centro cresce com |p|
+template<typename T>
+T paddedHalf(T lo, T hi, T reach){
+    const T slack = tolerance2<T>::slack;
+    return T(0.5) * (hi - lo) * (T(1) + slack) + slack * (std::max(std::fabs(lo), std::fabs(hi)) + reach);
+}
+
+// A soma longa fica em double também para pontos em float
+template<typename T>
+ponto2D centroidOf(const std::vector<vector2<T>>& points){
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    for(const auto& p: points){
+        sum_x += p.x;
+        sum_y += p.y;
+    }
+
+    return ponto2D{(sum_x/points.size()), (sum_y/points.size())};
+}
+
+}
+
+ponto2D calculateCentroid(const std::vector<ponto2D>& sub){
+    return centroidOf(sub);
+}
+
+template<typename T>
+vector2<T> aabb2<T>::corner(int i) const{
+    return vector2<T>((i & 1) ? max_x : min_x, (i & 2) ? max_y : min_y);
+}
+
+template<typename T>
+aabb2<T> computeAABB2(const std::vector<vector2<T>>& points){
+    if(points.empty()){
+        return aabb2<T>{0, 0, 0, 0};
+    }
+
+    aabb2<T> box{points[0].x, points[0].y, points[0].x, points[0].y};
+    for(const auto& p : points){
+        box.min_x = std::min(box.min_x, p.x);
+        box.min_y = std::min(box.min_y, p.y);
+        box.max_x = std::max(box.max_x, p.x);
+        box.max_y = std::max(box.max_y, p.y);
+    }
+
+    // Em float cada coordenada guardada está a menos de um ulp da original
+    if(std::is_same<T, float>::value){
+        const T down = std::numeric_limits<T>::lowest(), up = std::numeric_limits<T>::max();
+        box.min_x = std::nextafter(box.min_x, down);
+        box.min_y = std::nextafter(box.min_y, down);
+        box.max_x = std::nextafter(box.max_x, up);
+        box.max_y = std::nextafter(box.max_y, up);
+    }
+    return box;
+}
+
+template<typename T>
+circle2<T> computeCircle2(const std::vector<vector2<T>>& points){
+    if(points.empty()){
+        return circle2<T>(vector2<T>(), T(0));
+    }
+
+    // Compara as distâncias ao quadrado e tira uma raiz só no final
+    ponto2D centroid = centroidOf(points);
+    double radius2 = 0.0;
+    for(const auto& p : points){
+        radius2 = std::max(radius2, distanceSquared(centroid, ponto2D(p.x, p.y)));
+    }
+
+    // O raio cobre também o arredondamento do centro para T
+    vector2<T> center(T(centroid.x), T(centroid.y));
+    double shift = length(ponto2D(center.x, center.y) - centroid);
+    double reach = std::fabs(centroid.x) + std::fabs(centroid.y);
+    const double slack = tolerance2<T>::slack;
+    return circle2<T>(center, T((std::sqrt(radius2) + shift) * (1.0 + slack) + slack * reach));
+}
+
+template<typename T>
+obb2<T> computeOBB2(const std::vector<vector2<T>>& points, const vector2<T>& U){
+    vector2<T> V(-U.y, U.x);
+    if(points.empty()){
+        return obb2<T>(vector2<T>(), vector2<T>(), U, V);
+    }
+
+    // Projeções relativas ao centróide: em float, projetar as coordenadas absolutas
+    // perderia os dígitos do tamanho da caixa quando ela está longe da origem
+    ponto2D centroid = centroidOf(points);
+    vector2<T> origin(T(centroid.x), T(centroid.y));
+
+    T min_u = std::numeric_limits<T>::infinity();
+    T min_v = std::numeric_limits<T>::infinity();
+    T max_u = -std::numeric_limits<T>::infinity();
+    T max_v = -std::numeric_limits<T>::infinity();
+    for(const auto& p : points){
+        vector2<T> d = p - origin;
+        T proj_u = dot(d, U);
+        T proj_v = dot(d, V);
+
+        min_u = std::min(min_u, proj_u);
+        min_v = std::min(min_v, proj_v);
+        max_u = std::max(max_u, proj_u);
+        max_v = std::max(max_v, proj_v);
+    }
+
+    T reach = std::fabs(origin.x) + std::fabs(origin.y);
+    vector2<T> center = origin + U * (T(0.5) * (min_u + max_u)) + V * (T(0.5) * (min_v + max_v));
+    vector2<T> half_sizes(paddedHalf(min_u, max_u, reach), paddedHalf(min_v, max_v, reach));
+    return obb2<T>(center, half_sizes, U, V);
+}
+
+template<typename T>
+bool pointInAABB2(const aabb2<T>& box, const vector2<T>& p){
+    return (p.x >= box.min_x) & (p.x <= box.max_x) & (p.y >= box.min_y) & (p.y <= box.max_y);
+}
+
+template<typename T>
+bool pointInCircle2(const circle2<T>& circle, const vector2<T>& p){
+    return distanceSquared(p, circle.first) <= circle.second * circle.second;
+}
+
+template<typename T>
+bool pointInOBB2(const obb2<T>& box, const vector2<T>& p){
+    const auto& [center, half_sizes, U, V] = box;
+    vector2<T> d = p - center;
+    return (std::fabs(dot(d, U)) <= half_sizes.x) & (std::fabs(dot(d, V)) <= half_sizes.y);
+}
+
+template<typename T>
+bool overlapAABB2(const aabb2<T>& a, const aabb2<T>& b){
+    return (a.min_x <= b.max_x) & (b.min_x <= a.max_x) & (a.min_y <= b.max_y) & (b.min_y <= a.max_y);
+}
+
+template<typename T>
+bool overlapCircles2(const circle2<T>& a, const circle2<T>& b){
+    T reach = a.second + b.second;
+    return distanceSquared(a.first, b.first) <= reach * reach;
+}
+
+template<typename T>
+bool overlapOBB2(const obb2<T>& a, const obb2<T>& b){
+    const auto& [center_a, half_a, U_a, V_a] = a;
+    const auto& [center_b, half_b, U_b, V_b] = b;
+    vector2<T> d = center_b - center_a;
+
+    const vector2<T> axes[4] = {U_a, V_a, U_b, V_b};
+    for(const auto& L : axes){
+        T ra = half_a.x * std::fabs(dot(U_a, L)) + half_a.y * std::fabs(dot(V_a, L));
+        T rb = half_b.x * std::fabs(dot(U_b, L)) + half_b.y * std::fabs(dot(V_b, L));
+        if(std::fabs(dot(d, L)) > ra + rb){
+            return false;
+        }
+    }
+    return true;
+}
+
+template struct aabb2<double>;
+template struct aabb2<float>;
+template aabb2D computeAABB2(const std::vector<ponto2D>&);
+template aabb2f computeAABB2(const std::vector<vec2f>&);
+template circle2D computeCircle2(const std::vector<ponto2D>&);
+template circle2f computeCircle2(const std::vector<vec2f>&);
+template obb2D computeOBB2(const std::vector<ponto2D>&, const ponto2D&);
+template obb2f computeOBB2(const std::vector<vec2f>&, const vec2f&);
+template bool pointInAABB2(const aabb2D&, const ponto2D&);
+template bool pointInAABB2(const aabb2f&, const vec2f&);
+template bool pointInCircle2(const circle2D&, const ponto2D&);
+template bool pointInCircle2(const circle2f&, const vec2f&);
+template bool pointInOBB2(const obb2D&, const ponto2D&);
+template bool pointInOBB2(const obb2f&, const vec2f&);
+template bool overlapAABB2(const aabb2D&, const aabb2D&);
+template bool overlapAABB2(const aabb2f&, const aabb2f&);
+template bool overlapCircles2(const circle2D&, const circle2D&);
+template bool overlapCircles2(const circle2f&, const circle2f&);
+template bool overlapOBB2(const obb2D&, const obb2D&);
+template bool overlapOBB2(const obb2f&, const obb2f&);
+
+bool overlapAABB(const aabb2D& a, const aabb2D& b, aabb2D& overlap){
+    overlap.min_x = std::max(a.min_x, b.min_x);
+    overlap.min_y = std::max(a.min_y, b.min_y);
+    overlap.max_x = std::min(a.max_x, b.max_x);
+    overlap.max_y = std::min(a.max_y, b.max_y);
+
+    return (overlap.min_x <= overlap.max_x) & (overlap.min_y <= overlap.max_y);
+}
+
+int aabbCrossings(const aabb2D& a, const aabb2D& b, const aabb2D& overlap, ponto2D out[4]){
+    // Todo canto de 'overlap' está dentro de a e de b; basta saber se ele
+    // encosta na borda de cada uma.
+    int count = 0;
+    for(int i = 0; i < 4; ++i){
+        ponto2D p = overlap.corner(i);
+
+        bool onA = (p.x == a.min_x) | (p.x == a.max_x) | (p.y == a.min_y) | (p.y == a.max_y);
+        bool onB = (p.x == b.min_x) | (p.x == b.max_x) | (p.y == b.min_y) | (p.y == b.max_y);
+
+        // Sobreposição degenerada (caixas encostadas) repete cantos
+        bool repeated = false;
+        for(int k = 0; k < count; ++k){
+            repeated |= (out[k].x == p.x) & (out[k].y == p.y);
+        }
+
+        out[count] = p;
+        count += onA & onB & !repeated;
+    }
+
+    return count;
+}
+
+aabbSoA::aabbSoA(std::pmr::memory_resource* memory): min_x{memory}, min_y{memory}, max_x{memory}, max_y{memory} {}
+
+void aabbSoA::assign(const std::vector<aabb2D>& boxes){
+    min_x.resize(boxes.size());
+    min_y.resize(boxes.size());
+    max_x.resize(boxes.size());
+    max_y.resize(boxes.size());
+
+    for(std::size_t i = 0; i < boxes.size(); ++i){
+        min_x[i] = boxes[i].min_x;
+        min_y[i] = boxes[i].min_y;
+        max_x[i] = boxes[i].max_x;
+        max_y[i] = boxes[i].max_y;
+    }
+}
+
+std::size_t aabbSoA::size() const{
+    return min_x.size();
+}
+
+void overlapAABBBatch(const aabb2D& box, const aabbSoA& boxes, std::size_t first, std::size_t last, unsigned char* __restrict mask){
+    const double* __restrict min_x = boxes.min_x.data();
+    const double* __restrict min_y = boxes.min_y.data();
+    const double* __restrict max_x = boxes.max_x.data();
+    const double* __restrict max_y = boxes.max_y.data();
+
+    for(std::size_t k = first; k < last; ++k){
+        double lo_x = std::max(box.min_x, min_x[k]);
+        double lo_y = std::max(box.min_y, min_y[k]);
+        double hi_x = std::min(box.max_x, max_x[k]);
+        double hi_y = std::min(box.max_y, max_y[k]);
+
+        mask[k - first] = (lo_x <= hi_x) & (lo_y <= hi_y);
+    }
+}
+
+template<int D>
+ponto2D kdopAxis(int k){
+    // Tabela calculada uma vez por D
+    static const std::array<ponto2D, D> axes = []{
+        std::array<ponto2D, D> table;
+        for(int i = 0; i < D; ++i){
+            table[i] = ponto2D(std::cos(i * M_PI / D), std::sin(i * M_PI / D));
+        }
+        return table;
+    }();
+    return axes[k];
+}
+
+template<int D>
+kdop2D<D> computeKDOP(const std::vector<ponto2D>& points){
+    double ax[D], ay[D];
+    for(int k = 0; k < D; ++k){
+        ponto2D axis = kdopAxis<D>(k);
+        ax[k] = axis.x;
+        ay[k] = axis.y;
+    }
+
+    kdop2D<D> dop;
+    for(int k = 0; k < D; ++k){
+        dop.lo[k] = std::numeric_limits<double>::infinity();
+        dop.hi[k] = -std::numeric_limits<double>::infinity();
+    }
+
+    for(const auto& p : points){
+        for(int k = 0; k < D; ++k){
+            double t = p.x * ax[k] + p.y * ay[k];
+            dop.lo[k] = std::min(dop.lo[k], t);
+            dop.hi[k] = std::max(dop.hi[k], t);
+        }
+    }
+    return dop;
+}
+
+template<int D>
+bool overlapKDOP(const kdop2D<D>& a, const kdop2D<D>& b){
+    bool result = true;
+    for(int k = 0; k < D; ++k){
+        result &= (a.lo[k] <= b.hi[k]) & (b.lo[k] <= a.hi[k]);
+    }
+    return result;
+}
+
+template<int D>
+bool pointInKDOP(const kdop2D<D>& dop, const ponto2D& p){
+    bool result = true;
+    for(int k = 0; k < D; ++k){
+        ponto2D axis = kdopAxis<D>(k);
+        double t = dot(p, axis);
+        result &= (dop.lo[k] <= t) & (t <= dop.hi[k]);
+    }
+    return result;
+}
+
+template<int D>
+int kdopVertices(const kdop2D<D>& dop, ponto2D out[2 * D]){
+    // Faces em ordem angular: normais n_k = eixo k com deslocamento hi[k], e depois
+    // -eixo k com -lo[k]. Todas tocam os pontos, então o vértice entre duas faces
+    // vizinhas é a interseção das retas delas.
+    ponto2D normal[2 * D];
+    double offset[2 * D];
+    for(int k = 0; k < D; ++k){
+        ponto2D axis = kdopAxis<D>(k);
+        normal[k] = axis;
+        offset[k] = dop.hi[k];
+        normal[k + D] = axis * -1.0;
+        offset[k + D] = -dop.lo[k];
+    }
+
+    for(int f = 0; f < 2 * D; ++f){
+        int g = (f + 1) % (2 * D);
+        // n_f . p = o_f e n_g . p = o_g (regra de Cramer)
+        double det = normal[f].x * normal[g].y - normal[f].y * normal[g].x;
+        out[f] = ponto2D((offset[f] * normal[g].y - offset[g] * normal[f].y) / det,
+                         (normal[f].x * offset[g] - normal[g].x * offset[f]) / det);
+    }
+    return 2 * D;
+}
+
+template ponto2D kdopAxis<4>(int);
+template ponto2D kdopAxis<8>(int);
+template dop8 computeKDOP<4>(const std::vector<ponto2D>&);
+template dop16 computeKDOP<8>(const std::vector<ponto2D>&);
+template bool overlapKDOP<4>(const dop8&, const dop8&);
+template bool overlapKDOP<8>(const dop16&, const dop16&);
+template bool pointInKDOP<4>(const dop8&, const ponto2D&);
+template bool pointInKDOP<8>(const dop16&, const ponto2D&);
+template int kdopVertices<4>(const dop8&, ponto2D*);
+template int kdopVertices<8>(const dop16&, ponto2D*);
+
+namespace {
+
+// Menor semi-eixo admitido, para conjuntos degenerados (um ponto, pontos colineares)
+const double minimumSemiAxis = 1e-9;
+
+// Folga relativa dos ajustes: sem ela os pontos da borda falham o teste de
+// pertinência por arredondamento
+const double fitMargin = 1.0 + 1e-9;
+
+// Direção principal (autovetor do maior autovalor) da matriz simétrica [xx xy; xy yy]
+ponto2D principalAxis(double xx, double xy, double yy){
+    double angle = 0.5 * std::atan2(2.0 * xy, xx - yy);
+    return ponto2D(std::cos(angle), std::sin(angle));
+}
+
+// Raiz de F(s) = (r0 z0 / (s + r0))^2 + (z1 / (s + 1))^2 - 1 por bisseção (Eberly,
+// "Distance from a Point to an Ellipse"). Converge em no máximo ~1100 passos em double.
+double ellipseRoot(double r0, double z0, double z1, double g){
+    double n0 = r0 * z0;
+    double s0 = z1 - 1.0;
+    double s1 = (g < 0.0) ? 0.0 : std::sqrt(n0 * n0 + z1 * z1) - 1.0;
+    double s = 0.0;
+    for(int i = 0; i < 1100; ++i){
+        s = 0.5 * (s0 + s1);
+        if(s == s0 || s == s1){
+            break;
+        }
+        double ratio0 = n0 / (s + r0);
+        double ratio1 = z1 / (s + 1.0);
+        g = ratio0 * ratio0 + ratio1 * ratio1 - 1.0;
+        if(g > 0.0){
+            s0 = s;
+        }else if(g < 0.0){
+            s1 = s;
+        }else{
+            break;
+        }
+    }
+    return s;
+}
+
+// Ponto mais próximo de y na borda da elipse de semi-eixos e0 >= e1 > 0 alinhada
+// aos eixos, com y no primeiro quadrante
+ponto2D closestOnEllipse(double e0, double e1, double y0, double y1){
+    if(y1 > 0.0){
+        if(y0 > 0.0){
+            double z0 = y0 / e0;
+            double z1 = y1 / e1;
+            double g = z0 * z0 + z1 * z1 - 1.0;
+            if(g == 0.0){
+                return ponto2D(y0, y1);
+            }
+            double r0 = (e0 / e1) * (e0 / e1);
+            double sbar = ellipseRoot(r0, z0, z1, g);
+            return ponto2D(r0 * y0 / (sbar + r0), y1 / (sbar + 1.0));
+        }
+        return ponto2D(0.0, e1);
+    }
+
+    double numer0 = e0 * y0;
+    double denom0 = e0 * e0 - e1 * e1;
+    if(numer0 < denom0){
+        double xde0 = numer0 / denom0;
+        return ponto2D(e0 * xde0, e1 * std::sqrt(1.0 - xde0 * xde0));
+    }
+    return ponto2D(e0, 0.0);
+}
+
+// Determinante relativo (det / produto da diagonal, que o limita em matrizes positivas
+// definidas) abaixo do qual invert3 considera a matriz singular
+const double singularDeterminant = 1e-12;
+
+// Inversa de uma matriz 3x3 simétrica positiva definida (cofatores). Retorna false,
+// sem escrever um resultado útil, se ela for singular ou quase: pontos (quase) colineares.
+bool invert3(const double m[3][3], double inv[3][3]){
+    inv[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    inv[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+    inv[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    inv[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    inv[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+    inv[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    inv[2][0] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    inv[2][1] = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+    inv[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+    double det = m[0][0] * inv[0][0] + m[0][1] * inv[1][0] + m[0][2] * inv[2][0];
+    double scale = std::fabs(m[0][0] * m[1][1] * m[2][2]);
+    if(!(det > singularDeterminant * scale) || !std::isfinite(det)){
+        return false;
+    }
+    for(int r = 0; r < 3; ++r){
+        for(int c = 0; c < 3; ++c){
+            inv[r][c] /= det;
+        }
+    }
+    return true;
+}
+
+double distanceToSegment(const ponto2D& p, const ponto2D& a, const ponto2D& b){
+    ponto2D ab = b - a;
+    double length2 = dot(ab, ab);
+    double t = length2 > 0.0 ? std::clamp(dot(p - a, ab) / length2, 0.0, 1.0) : 0.0;
+    ponto2D d = p - (a + ab * t);
+    return length(d);
+}
+
+}
+
+capsule2D fitCapsule(const std::vector<ponto2D>& points){
+    if(points.empty()){
+        return capsule2D{ponto2D(), ponto2D(), 0.0};
+    }
+
+    ponto2D mean;
+    for(const auto& p : points){
+        mean = mean + p;
+    }
+    mean = mean * (1.0 / points.size());
+
+    double xx = 0.0, xy = 0.0, yy = 0.0;
+    for(const auto& p : points){
+        ponto2D d = p - mean;
+        xx += d.x * d.x;
+        xy += d.x * d.y;
+        yy += d.y * d.y;
+    }
+
+    ponto2D U = principalAxis(xx, xy, yy);
+    ponto2D V(-U.y, U.x);
+
+    // Espessura na direção V: define a linha do eixo (s0) e o raio
+    double s_min = std::numeric_limits<double>::infinity();
+    double s_max = -std::numeric_limits<double>::infinity();
+    for(const auto& p : points){
+        double s = dot(p - mean, V);
+        s_min = std::min(s_min, s);
+        s_max = std::max(s_max, s);
+    }
+    double s0 = 0.5 * (s_min + s_max);
+    double radius = 0.5 * (s_max - s_min);
+
+    // Cada ponto limita o quanto as pontas podem recuar: ele precisa caber na
+    // semicircunferência da ponta do seu lado
+    double t_lo = std::numeric_limits<double>::infinity();
+    double t_hi = -std::numeric_limits<double>::infinity();
+    for(const auto& p : points){
+        ponto2D d = p - mean;
+        double t = dot(d, U);
+        double ds = dot(d, V) - s0;
+        double h = std::sqrt(std::max(0.0, radius * radius - ds * ds));
+        t_lo = std::min(t_lo, t + h);
+        t_hi = std::max(t_hi, t - h);
+    }
+
+    capsule2D capsule;
+    if(t_lo <= t_hi){
+        capsule.a = mean + U * t_lo + V * s0;
+        capsule.b = mean + U * t_hi + V * s0;
+        capsule.radius = radius;
+    }else{
+        // Conjunto "redondo": o segmento degenera em um ponto e o raio cresce
+        capsule.a = mean + U * (0.5 * (t_lo + t_hi)) + V * s0;
+        capsule.b = capsule.a;
+        capsule.radius = 0.0;
+        for(const auto& p : points){
+            ponto2D d = p - capsule.a;
+            capsule.radius = std::max(capsule.radius, length(d));
+        }
+    }
+    capsule.radius = std::max(capsule.radius * fitMargin, minimumSemiAxis);
+    return capsule;
+}
+
+ellipse2D fitEllipse(const std::vector<ponto2D>& points, double tolerance, int maxIterations){
+    // A elipse mínima só depende dos vértices do fecho
+    std::vector<ponto2D> hull = convexHull(points);
+    if(hull.empty()){
+        return ellipse2D{ponto2D(), minimumSemiAxis, minimumSemiAxis, ponto2D(1.0, 0.0)};
+    }
+    if(hull.size() < 3){
+        ponto2D center = (hull.front() + hull.back()) * 0.5;
+        ponto2D d = hull.back() - hull.front();
+        double length = ::length(d);
+        ponto2D U = length > 0.0 ? d * (1.0 / length) : ponto2D(1.0, 0.0);
+        return ellipse2D{center, std::max(0.5 * length, minimumSemiAxis), minimumSemiAxis, U};
+    }
+
+    // Coordenadas relativas à média: X fica bem condicionada
+    std::size_t n = hull.size();
+    ponto2D mean;
+    for(const auto& p : hull){
+        mean = mean + p;
+    }
+    mean = mean * (1.0 / n);
+
+    std::vector<ponto2D> q(n);
+    for(std::size_t i = 0; i < n; ++i){
+        q[i] = hull[i] - mean;
+    }
+
+    std::vector<double> u(n, 1.0 / n);
+
+    // Khachiyan: X = sum u_i q_i q_i^T com q_i = (x, y, 1); o ponto de maior
+    // q_i^T X^-1 q_i recebe mais peso até o passo ficar desprezível
+    for(int iteration = 0; iteration < maxIterations; ++iteration){
+        double X[3][3] = {};
+        for(std::size_t i = 0; i < n; ++i){
+            double v[3] = {q[i].x, q[i].y, 1.0};
+            for(int r = 0; r < 3; ++r){
+                for(int c = 0; c < 3; ++c){
+                    X[r][c] += u[i] * v[r] * v[c];
+                }
+            }
+        }
+
+        // Fecho quase degenerado: fica com os pesos atuais; a ampliação do fim garante
+        // que a elipse contém todos os vértices
+        double inv[3][3];
+        if(!invert3(X, inv)){
+            break;
+        }
+
+        std::size_t j = 0;
+        double maximum = -1.0;
+        for(std::size_t i = 0; i < n; ++i){
+            double v[3] = {q[i].x, q[i].y, 1.0};
+            double m = 0.0;
+            for(int r = 0; r < 3; ++r){
+                for(int c = 0; c < 3; ++c){
+                    m += v[r] * inv[r][c] * v[c];
+                }
+            }
+            if(m > maximum){
+                maximum = m;
+                j = i;
+            }
+        }
+
+        // d = 2: passo = (M_j - d - 1) / ((d + 1)(M_j - 1))
+        double step = (maximum - 3.0) / (3.0 * (maximum - 1.0));
+        for(auto& w : u){
+            w *= 1.0 - step;
+        }
+        u[j] += step;
+
+        if(step < tolerance){
+            break;
+        }
+    }
+
+    // Centro e forma: A^-1 = d * (sum u_i p_i p_i^T - c c^T)
+    ponto2D c;
+    for(std::size_t i = 0; i < n; ++i){
+        c = c + q[i] * u[i];
+    }
+    double xx = 0.0, xy = 0.0, yy = 0.0;
+    for(std::size_t i = 0; i < n; ++i){
+        xx += u[i] * q[i].x * q[i].x;
+        xy += u[i] * q[i].x * q[i].y;
+        yy += u[i] * q[i].y * q[i].y;
+    }
+    xx = 2.0 * (xx - c.x * c.x);
+    xy = 2.0 * (xy - c.x * c.y);
+    yy = 2.0 * (yy - c.y * c.y);
+
+    double half_trace = 0.5 * (xx + yy);
+    double spread = std::sqrt(0.25 * (xx - yy) * (xx - yy) + xy * xy);
+
+    ellipse2D ellipse;
+    ellipse.center = mean + c;
+    ellipse.U = principalAxis(xx, xy, yy);
+    ellipse.semi_u = std::sqrt(std::max(half_trace + spread, 0.0));
+    ellipse.semi_v = std::sqrt(std::max(half_trace - spread, 0.0));
+    ellipse.semi_u = std::max(ellipse.semi_u, minimumSemiAxis);
+    ellipse.semi_v = std::max(ellipse.semi_v, minimumSemiAxis);
+
+    // A aproximação pode deixar vértices um pouco para fora: amplia o necessário
+    ponto2D V(-ellipse.U.y, ellipse.U.x);
+    double worst = 1.0;
+    for(const auto& p : hull){
+        ponto2D d = p - ellipse.center;
+        double a = dot(d, ellipse.U) / ellipse.semi_u;
+        double b = dot(d, V) / ellipse.semi_v;
+        worst = std::max(worst, a * a + b * b);
+    }
+    ellipse.semi_u *= std::sqrt(worst) * fitMargin;
+    ellipse.semi_v *= std::sqrt(worst) * fitMargin;
+
+    return ellipse;
+}
+
+bool pointInCapsule(const capsule2D& capsule, const ponto2D& p){
+    return distanceToSegment(p, capsule.a, capsule.b) <= capsule.radius;
+}
+
+bool pointInEllipse(const ellipse2D& ellipse, const ponto2D& p){
+    ponto2D d = p - ellipse.center;
+    ponto2D V(-ellipse.U.y, ellipse.U.x);
+    double a = dot(d, ellipse.U) / ellipse.semi_u;
+    double b = dot(d, V) / ellipse.semi_v;
+    return a * a + b * b <= 1.0;
+}
+
+void closestSegmentPoints(const ponto2D& p1, const ponto2D& q1, const ponto2D& p2, const ponto2D& q2, ponto2D& c1, ponto2D& c2){
+    ponto2D d1 = q1 - p1;
+    ponto2D d2 = q2 - p2;
+    ponto2D r = p1 - p2;
+    double a = dot(d1, d1);
+    double e = dot(d2, d2);
+    double f = dot(d2, r);
+
+    double s, t;
+    if(a == 0.0 && e == 0.0){
+        s = t = 0.0;
+    }else if(a == 0.0){
+        s = 0.0;
+        t = std::clamp(f / e, 0.0, 1.0);
+    }else{
+        double c = dot(d1, r);
+        if(e == 0.0){
+            t = 0.0;
+            s = std::clamp(-c / a, 0.0, 1.0);
+        }else{
+            double b = dot(d1, d2);
+            double denom = a * e - b * b;
+            s = denom != 0.0 ? std::clamp((b * f - c * e) / denom, 0.0, 1.0) : 0.0;
+            t = (b * s + f) / e;
+            if(t < 0.0){
+                t = 0.0;
+                s = std::clamp(-c / a, 0.0, 1.0);
+            }else if(t > 1.0){
+                t = 1.0;
+                s = std::clamp((b - c) / a, 0.0, 1.0);
+            }
+        }
+    }
+
+    c1 = p1 + d1 * s;
+    c2 = p2 + d2 * t;
+}
+
+bool overlapCapsules(const capsule2D& a, const capsule2D& b){
+    ponto2D ca, cb;
+    closestSegmentPoints(a.a, a.b, b.a, b.b, ca, cb);
+    ponto2D d = cb - ca;
+    double reach = a.radius + b.radius;
+    return dot(d, d) <= reach * reach;
+}
+
+bool overlapEllipses(const ellipse2D& a, const ellipse2D& b, ponto2D& point, double& distance){
+    ponto2D Va(-a.U.y, a.U.x);
+    ponto2D Vb(-b.U.y, b.U.x);
+
+    // Espaço de b: x' = diag(1/su, 1/sv) R_b^T (x - c_b). Nele, a vira c' + M w, |w| <= 1
+    auto toB = [&](const ponto2D& d){
+        return ponto2D(dot(d, b.U) / b.semi_u, dot(d, Vb) / b.semi_v);
+    };
+    ponto2D c = toB(a.center - b.center);
+    ponto2D m0 = toB(a.U * a.semi_u);   // Colunas de M
+    ponto2D m1 = toB(Va * a.semi_v);
+
+    // M M^T = P S^2 P^T: eixos (P) e semi-eixos (S) de a no espaço de b
+    double xx = m0.x * m0.x + m1.x * m1.x;
+    double xy = m0.x * m0.y + m1.x * m1.y;
+    double yy = m0.y * m0.y + m1.y * m1.y;
+    double half_trace = 0.5 * (xx + yy);
+    double spread = std::sqrt(0.25 * (xx - yy) * (xx - yy) + xy * xy);
+    double e0 = std::sqrt(half_trace + spread);
+    double e1 = std::sqrt(std::max(half_trace - spread, 0.0));
+    e1 = std::max(e1, minimumSemiAxis * e0);
+    ponto2D P0 = principalAxis(xx, xy, yy);
+    ponto2D P1(-P0.y, P0.x);
+
+    // Origem (centro de b) nas coordenadas dos eixos de a
+    ponto2D y(-dot(c, P0), -dot(c, P1));
+
+    ponto2D fromB;
+    if((y.x / e0) * (y.x / e0) + (y.y / e1) * (y.y / e1) <= 1.0){
+        // O centro de b está dentro de a
+        distance = 0.0;
+        fromB = ponto2D();
+    }else{
+        ponto2D x = closestOnEllipse(e0, e1, std::fabs(y.x), std::fabs(y.y));
+        x.x = std::copysign(x.x, y.x);
+        x.y = std::copysign(x.y, y.y);
+        ponto2D d = y - x;
+        distance = length(d);
+        fromB = c + P0 * x.x + P1 * x.y;
+    }
+
+    // De volta ao mundo
+    point = b.center + b.U * (fromB.x * b.semi_u) + Vb * (fromB.y * b.semi_v);
+    return distance <= 1.0;
+}
+
+namespace {
+
+const char* kindNames[VOLUME_KINDS] = {"AABB", "Circulo", "OBB", "Capsula", "Elipse"};
+
+}
+
+taggedVolume makeVolume(const aabb2D& box){
+    return taggedVolume{ponto2D(0.5 * (box.min_x + box.max_x), 0.5 * (box.min_y + box.max_y)), ponto2D(1.0, 0.0),
+                        0.5 * (box.max_x - box.min_x), 0.5 * (box.max_y - box.min_y), VOLUME_AABB};
+}
+
+taggedVolume makeVolume(const circle2D& circle){
+    return taggedVolume{circle.first, ponto2D(1.0, 0.0), circle.second, circle.second, VOLUME_CIRCLE};
+}
+
+taggedVolume makeVolume(const obb2D& box){
+    auto [center, half_sizes, U, V] = box;
+    return taggedVolume{center, U, half_sizes.x, half_sizes.y, VOLUME_OBB};
+}
+
+taggedVolume makeVolume(const capsule2D& capsule){
+    ponto2D axis = capsule.b - capsule.a;
+    double length = ::length(axis);
+    ponto2D U = length > 0.0 ? axis * (1.0 / length) : ponto2D(1.0, 0.0);
+    return taggedVolume{(capsule.a + capsule.b) * 0.5, U, 0.5 * length, capsule.radius, VOLUME_CAPSULE};
+}
+
+taggedVolume makeVolume(const ellipse2D& ellipse){
+    return taggedVolume{ellipse.center, ellipse.U, ellipse.semi_u, ellipse.semi_v, VOLUME_ELLIPSE};
+}
+
+aabb2D volumeAABB(const taggedVolume& v){
+    return aabb2D{v.center.x - v.e0, v.center.y - v.e1, v.center.x + v.e0, v.center.y + v.e1};
+}
+
+circle2D volumeCircle(const taggedVolume& v){
+    return circle2D(v.center, v.e0);
+}
+
+obb2D volumeOBB(const taggedVolume& v){
+    return obb2D(v.center, ponto2D(v.e0, v.e1), v.U, ponto2D(-v.U.y, v.U.x));
+}
+
+capsule2D volumeCapsule(const taggedVolume& v){
+    return capsule2D{v.center - v.U * v.e0, v.center + v.U * v.e0, v.e1};
+}
+
+ellipse2D volumeEllipse(const taggedVolume& v){
+    return ellipse2D{v.center, v.e0, v.e1, v.U};
+}
+
+const char* volumeKindName(int kind){
+    return (kind >= 0 && kind < VOLUME_KINDS) ? kindNames[kind] : "?";
+}
+
+double volumeArea(const taggedVolume& v){
+    switch(v.kind){
+        case VOLUME_AABB:
+        case VOLUME_OBB:
+            return 4.0 * v.e0 * v.e1;
+        case VOLUME_CIRCLE:
+            return M_PI * v.e0 * v.e0;
+        case VOLUME_CAPSULE:
+            return 4.0 * v.e0 * v.e1 + M_PI * v.e1 * v.e1;
+        default:
+            return M_PI * v.e0 * v.e1;
+    }
+}
+
+bool pointInVolume(const taggedVolume& v, const ponto2D& p){
+    ponto2D d = p - v.center;
+    double u = dot(d, v.U);
+    double w = d.y * v.U.x - d.x * v.U.y;   // d . V, com V = U girado 90 graus
+
+    switch(v.kind){
+        case VOLUME_AABB:
+        case VOLUME_OBB:
+            return (std::fabs(u) <= v.e0) & (std::fabs(w) <= v.e1);
+        case VOLUME_CIRCLE:
+            return dot(d, d) <= v.e0 * v.e0;
+        case VOLUME_CAPSULE: {
+            double along = std::fabs(u) - std::min(std::fabs(u), v.e0);
+            return along * along + w * w <= v.e1 * v.e1;
+        }
+        default:
+            return (u / v.e0) * (u / v.e0) + (w / v.e1) * (w / v.e1) <= 1.0;
+    }
+}
+
+ponto2D volumeSupport(const taggedVolume& v, const ponto2D& d){
+    ponto2D V(-v.U.y, v.U.x);
+    double du = dot(d, v.U);
+    double dv = dot(d, V);
+
+    switch(v.kind){
+        case VOLUME_AABB:
+        case VOLUME_OBB:
+            return v.center + v.U * (du >= 0.0 ? v.e0 : -v.e0) + V * (dv >= 0.0 ? v.e1 : -v.e1);
+        case VOLUME_CIRCLE:
+        case VOLUME_CAPSULE: {
+            double length = ::length(d);
+            double along = v.kind == VOLUME_CAPSULE ? (du >= 0.0 ? v.e0 : -v.e0) : 0.0;
+            double radius = v.kind == VOLUME_CAPSULE ? v.e1 : v.e0;
+            ponto2D tip = v.center + v.U * along;
+            return length > 0.0 ? tip + d * (radius / length) : tip;
+        }
+        default: {
+            // Máximo de d . x sobre x = c + U e0 cos(t) + V e1 sin(t)
+            double a = du * v.e0;
+            double b = dv * v.e1;
+            double length = std::sqrt(a * a + b * b);
+            if(length == 0.0){
+                return v.center;
+            }
+            return v.center + v.U * (v.e0 * a / length) + V * (v.e1 * b / length);
+        }
+    }
+}
@@ -0,0 +1,790 @@
+#include "../Libraries/volumes3d.h"
+#include "../Libraries/extents3d.h"
+#include "../Libraries/random.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// As reduções de min/max (AABB3 e projeções da OBB3) ficam em extents3d.cpp, que tem
+// flags próprias para vetorizar.
+//
+// Tudo é template na precisão T das coordenadas (instanciado para double e float no
+// fim do arquivo). Os laços sobre os pontos trabalham em T; somas longas (centróide,
+// covariância), Jacobi, Ritter e Welzl ficam em double, que custa pouco e mantém
+// o erro do caminho em float no nível do arredondamento das coordenadas.
+
+namespace {
+
+const std::size_t tileSize = 64;
+
+// Tolerâncias por precisão
+template<typename T>
+struct tolerance3;
+
+template<>
+struct tolerance3<double>{
+    // Folga relativa dos ajustes, como em volumes.cpp: sem ela os pontos da borda
+    // falham o teste de pertinência por arredondamento
+    static constexpr double slack = 1e-9;
+    // Somada a |R| no SAT das OBB3, para arestas quase paralelas
+    static constexpr double parallel = 1e-12;
+};
+
+template<>
+struct tolerance3<float>{
+    // ~64 u: cobre o erro de d · eixo em float para pontos a |c| da origem
+    static constexpr float slack = 8e-6f;
+    static constexpr float parallel = 1e-6f;
+};
+
+// Meia dimensão do intervalo projetado [lo, hi], com folga proporcional também à
+// distância 'reach' da caixa à origem: pointInOBB3 calcula p - centro, e o erro disso
+// cresce com |p|, não com o tamanho da caixa
+template<typename T>
+T paddedHalf(T lo, T hi, T reach){
+    const T slack = tolerance3<T>::slack;
+    return T(0.5) * (hi - lo) * (T(1) + slack) + slack * (std::max(std::fabs(lo), std::fabs(hi)) + reach);
+}
+
+template<typename T>
+vec3 widen(const vector3<T>& v){
+    return vec3(v.x, v.y, v.z);
+}
+
+template<typename T>
+vector3<T> narrow(const vec3& v){
+    return vector3<T>(T(v.x), T(v.y), T(v.z));
+}
+
+// Esfera calculada em double guardada em T, com a folga relativa de T. O raio é
+// arredondado para cima o bastante para cobrir também o arredondamento do centro e,
+// como em paddedHalf, o das coordenadas guardadas, que cresce com a distância à origem.
+template<typename T>
+sphere3<T> narrowSphere(const sphere3D& sphere){
+    vector3<T> center = narrow<T>(sphere.first);
+    double shift = (widen(center) - sphere.first).norma();
+    double reach = std::fabs(sphere.first.x) + std::fabs(sphere.first.y) + std::fabs(sphere.first.z);
+    return sphere3<T>(center, T((sphere.second + shift) * (1.0 + tolerance3<T>::slack) + tolerance3<T>::slack * reach));
+}
+
+// Autovalores/autovetores da matriz simétrica 'a' (Jacobi cíclico). As colunas de v
+// são os autovetores; a diagonal de 'a' termina com os autovalores.
+void jacobiEigen(double a[3][3], double v[3][3]){
+    for(int r = 0; r < 3; ++r){
+        for(int c = 0; c < 3; ++c){
+            v[r][c] = (r == c) ? 1.0 : 0.0;
+        }
+    }
+
+    for(int sweep = 0; sweep < 50; ++sweep){
+        double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        double scale = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        if(off <= 1e-30 * scale || off == 0.0){
+            return;
+        }
+
+        for(int p = 0; p < 2; ++p){
+            for(int q = p + 1; q < 3; ++q){
+                if(std::fabs(a[p][q]) <= 1e-15 * (std::fabs(a[p][p]) + std::fabs(a[q][q]))){
+                    a[p][q] = a[q][p] = 0.0;
+                    continue;
+                }
+
+                double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                double c = 1.0 / std::sqrt(t * t + 1.0);
+                double s = t * c;
+
+                for(int k = 0; k < 3; ++k){
+                    double akp = a[k][p], akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for(int k = 0; k < 3; ++k){
+                    double apk = a[p][k], aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for(int k = 0; k < 3; ++k){
+                    double vkp = v[k][p], vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+}
+
+// Percorre os pares i < j (em blocos, em paralelo, quando há pool) e junta o
+// resultado em ordem de (i, j). row(i, first, last, out) testa i contra [first, last).
+template<typename Row>
+void collectPairs(std::size_t n, std::vector<std::pair<int, int>>& pairs, threadPool* pool, std::pmr::memory_resource* scratch, Row row){
+    pairs.clear();
+
+    if(pool == nullptr){
+        for(std::size_t i = 0; i < n; ++i){
+            row(i, i + 1, n, pairs);
+        }
+        return;
+    }
+
+    std::pmr::vector<pairTile> tiles = upperTriangleTiles(n, tileSize, scratch);
+    std::vector<std::vector<std::pair<int, int>>> perTile(tiles.size());
+
+    pool->parallelFor(tiles.size(), [&](std::size_t t){
+        const pairTile& tile = tiles[t];
+        for(std::size_t i = tile.i_begin; i < tile.i_end; ++i){
+            row(i, std::max(tile.j_begin, i + 1), tile.j_end, perTile[t]);
+        }
+    });
+
+    for(const auto& part : perTile){
+        pairs.insert(pairs.end(), part.begin(), part.end());
+    }
+    std::sort(pairs.begin(), pairs.end());
+}
+
+template<typename T>
+sphere3D centroidSphere(const cloud3<T>& cloud, std::size_t k){
+    const T* __restrict x = cloud.x.data();
+    const T* __restrict y = cloud.y.data();
+    const T* __restrict z = cloud.z.data();
+    std::size_t first = cloud.begin(k), last = cloud.end(k);
+
+    double cx = 0.0, cy = 0.0, cz = 0.0;
+    for(std::size_t i = first; i < last; ++i){
+        cx += x[i];
+        cy += y[i];
+        cz += z[i];
+    }
+    double inv = 1.0 / (last - first);
+    cx *= inv;
+    cy *= inv;
+    cz *= inv;
+
+    double radius2 = 0.0;
+    for(std::size_t i = first; i < last; ++i){
+        double dx = x[i] - cx, dy = y[i] - cy, dz = z[i] - cz;
+        radius2 = std::max(radius2, dx * dx + dy * dy + dz * dz);
+    }
+    return sphere3D(vec3(cx, cy, cz), std::sqrt(radius2));
+}
+
+// Contém, com tolerância relativa para os pontos que definem a própria esfera
+bool covers(const sphere3D& sphere, const vec3& p){
+    vec3 d = p - sphere.first;
+    return d.dot(d) <= sphere.second * sphere.second * (1.0 + 1e-10);
+}
+
+// Menor esfera com a e b na borda
+sphere3D sphereFrom(const vec3& a, const vec3& b){
+    vec3 center = (a + b) * 0.5;
+    return sphere3D(center, (a - center).norma());
+}
+
+// Menor esfera com a, b e c na borda: a circunferência circunscrita
+sphere3D sphereFrom(const vec3& a, const vec3& b, const vec3& c){
+    vec3 ab = b - a, ac = c - a;
+    vec3 n = ab.cross(ac);
+    double n2 = n.dot(n);
+    if(n2 <= 1e-24 * ab.dot(ab) * ac.dot(ac)){
+        // Colineares: o par mais afastado
+        sphere3D best = sphereFrom(a, b);
+        sphere3D other = sphereFrom(a, c);
+        if(other.second > best.second) best = other;
+        other = sphereFrom(b, c);
+        if(other.second > best.second) best = other;
+        return best;
+    }
+    vec3 offset = (n.cross(ab) * ac.dot(ac) + ac.cross(n) * ab.dot(ab)) * (0.5 / n2);
+    return sphere3D(a + offset, offset.norma());
+}
+
+// Esfera circunscrita ao tetraedro abcd; coplanares caem na menor esfera de três
+// deles que cobre os quatro
+sphere3D sphereFrom(const vec3& a, const vec3& b, const vec3& c, const vec3& d){
+    vec3 ab = b - a, ac = c - a, ad = d - a;
+    double det = ab.dot(ac.cross(ad));
+    double scale = ab.norma() * ac.norma() * ad.norma();
+    if(std::fabs(det) <= 1e-12 * scale){
+        const vec3* points[4] = {&a, &b, &c, &d};
+        sphere3D best(a, 0.0);
+        bool found = false;
+        for(int skip = 0; skip < 4; ++skip){
+            const vec3* t[3];
+            for(int i = 0, n = 0; i < 4; ++i){
+                if(i != skip) t[n++] = points[i];
+            }
+            sphere3D candidate = sphereFrom(*t[0], *t[1], *t[2]);
+            if(covers(candidate, *points[skip]) && (!found || candidate.second < best.second)){
+                best = candidate;
+                found = true;
+            }
+        }
+        return found ? best : sphereFrom(a, b, c);
+    }
+    double b2 = ab.dot(ab), c2 = ac.dot(ac), d2 = ad.dot(ad);
+    vec3 offset = (ac.cross(ad) * b2 + ad.cross(ab) * c2 + ab.cross(ac) * d2) * (0.5 / det);
+    return sphere3D(a + offset, offset.norma());
+}
+
+// Índice do ponto de [first, last) mais distante de p
+template<typename T>
+std::size_t farthestFrom(const cloud3<T>& cloud, std::size_t first, std::size_t last, const vec3& p){
+    const T* __restrict x = cloud.x.data();
+    const T* __restrict y = cloud.y.data();
+    const T* __restrict z = cloud.z.data();
+    double px = p.x, py = p.y, pz = p.z;
+
+    std::size_t best = first;
+    double bestDistance = 0.0;
+    for(std::size_t i = first; i < last; ++i){
+        double dx = x[i] - px, dy = y[i] - py, dz = z[i] - pz;
+        double distance = dx * dx + dy * dy + dz * dz;
+        if(distance > bestDistance){
+            bestDistance = distance;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Passada de Ritter: cada ponto fora da esfera a empurra até encostar nele
+template<typename T>
+sphere3D growSphere(const cloud3<T>& cloud, std::size_t first, std::size_t last, sphere3D sphere){
+    const T* __restrict x = cloud.x.data();
+    const T* __restrict y = cloud.y.data();
+    const T* __restrict z = cloud.z.data();
+    double cx = sphere.first.x, cy = sphere.first.y, cz = sphere.first.z;
+    double r = sphere.second, r2 = r * r;
+
+    for(std::size_t i = first; i < last; ++i){
+        double dx = x[i] - cx, dy = y[i] - cy, dz = z[i] - cz;
+        double distance2 = dx * dx + dy * dy + dz * dz;
+        if(distance2 > r2){
+            double distance = std::sqrt(distance2);
+            double grown = 0.5 * (r + distance);
+            double shift = (grown - r) / distance;
+            cx += dx * shift;
+            cy += dy * shift;
+            cz += dz * shift;
+            r = grown;
+            r2 = r * r;
+        }
+    }
+    return sphere3D(vec3(cx, cy, cz), r);
+}
+
+template<typename T>
+sphere3D ritterSphere(const cloud3<T>& cloud, std::size_t k){
+    std::size_t first = cloud.begin(k), last = cloud.end(k);
+    std::size_t a = farthestFrom(cloud, first, last, widen(cloud.point(first)));
+    std::size_t b = farthestFrom(cloud, first, last, widen(cloud.point(a)));
+    return growSphere(cloud, first, last, sphereFrom(widen(cloud.point(a)), widen(cloud.point(b))));
+}
+
+// Normais do EPOS (Larsson, "Fast and Tight Fitting Bounding Spheres"): eixos,
+// diagonais do cubo e diagonais das faces. Não precisam ser unitárias.
+const double eposNormals[13][3] = {
+    {1, 0, 0}, {0, 1, 0}, {0, 0, 1},
+    {1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1},
+    {1, 1, 0}, {1, -1, 0}, {1, 0, 1}, {1, 0, -1}, {0, 1, 1}, {0, 1, -1}
+};
+
+template<typename T>
+sphere3D eposSphere(const cloud3<T>& cloud, std::size_t k, int normals){
+    std::size_t first = cloud.begin(k), last = cloud.end(k);
+    thread_local std::vector<vec3> extremes;
+    extremes.clear();
+
+    // Poucos pontos: a esfera exata de todos sai mais barata que os extremos
+    if(last - first <= std::size_t(2 * normals)){
+        for(std::size_t i = first; i < last; ++i){
+            extremes.push_back(widen(cloud.point(i)));
+        }
+        return minimumSphere(extremes);
+    }
+
+    const T* __restrict x = cloud.x.data();
+    const T* __restrict y = cloud.y.data();
+    const T* __restrict z = cloud.z.data();
+    for(int n = 0; n < normals; ++n){
+        T nx = T(eposNormals[n][0]), ny = T(eposNormals[n][1]), nz = T(eposNormals[n][2]);
+        std::size_t lo = first, hi = first;
+        T loValue = nx * x[first] + ny * y[first] + nz * z[first], hiValue = loValue;
+        for(std::size_t i = first + 1; i < last; ++i){
+            T value = nx * x[i] + ny * y[i] + nz * z[i];
+            if(value < loValue){
+                loValue = value;
+                lo = i;
+            }
+            if(value > hiValue){
+                hiValue = value;
+                hi = i;
+            }
+        }
+        extremes.push_back(widen(cloud.point(lo)));
+        extremes.push_back(widen(cloud.point(hi)));
+    }
+
+    return growSphere(cloud, first, last, minimumSphere(extremes));
+}
+
+}
+
+template<typename T>
+void cloud3<T>::clear(){
+    x.clear();
+    y.clear();
+    z.clear();
+    offsets.assign(1, 0);
+}
+
+template<typename T>
+void cloud3<T>::addSubset(const std::vector<vector3<T>>& points){
+    for(const auto& p : points){
+        x.push_back(p.x);
+        y.push_back(p.y);
+        z.push_back(p.z);
+    }
+    offsets.push_back(x.size());
+}
+
+template<typename T>
+std::size_t cloud3<T>::subsets() const{
+    return offsets.size() - 1;
+}
+
+template<typename T>
+std::size_t cloud3<T>::points() const{
+    return x.size();
+}
+
+template<typename T>
+std::size_t cloud3<T>::begin(std::size_t k) const{
+    return offsets[k];
+}
+
+template<typename T>
+std::size_t cloud3<T>::end(std::size_t k) const{
+    return offsets[k + 1];
+}
+
+template<typename T>
+vector3<T> cloud3<T>::point(std::size_t i) const{
+    return vector3<T>(x[i], y[i], z[i]);
+}
+
+template<typename T, typename U>
+void convertCloud(const cloud3<U>& from, cloud3<T>& to){
+    to.x.assign(from.x.begin(), from.x.end());
+    to.y.assign(from.y.begin(), from.y.end());
+    to.z.assign(from.z.begin(), from.z.end());
+    to.offsets = from.offsets;
+}
+
+bool loadCloud3(const char* path, cloud3SoA& cloud){
+    std::ifstream file(path);
+    if(!file){
+        std::cerr << "Nao foi possivel abrir a nuvem " << path << std::endl;
+        return false;
+    }
+
+    cloud.clear();
+    std::vector<vec3> subset;
+    std::string line;
+    int number = 0;
+    while(std::getline(file, line)){
+        number++;
+        if(!line.empty() && line[0] == '#'){
+            continue;
+        }
+        if(line.find_first_not_of(" \t\r") == std::string::npos){
+            if(!subset.empty()){
+                cloud.addSubset(subset);
+                subset.clear();
+            }
+            continue;
+        }
+
+        std::istringstream in(line);
+        double px, py, pz;
+        if(!(in >> px >> py >> pz)){
+            std::cerr << path << ":" << number << ": esperado 'x y z'" << std::endl;
+            return false;
+        }
+        subset.emplace_back(px, py, pz);
+    }
+    if(!subset.empty()){
+        cloud.addSubset(subset);
+    }
+    return true;
+}
+
+const char* sphereMethodName(int method){
+    static const char* names[] = {"centroide", "Ritter", "EPOS-6", "EPOS-14", "EPOS-26", "Welzl"};
+    return (method >= 0 && method < SPHERE_METHODS) ? names[method] : "?";
+}
+
+sphere3D minimumSphere(std::vector<vec3>& points){
+    if(points.empty()){
+        return sphere3D(vec3(), 0.0);
+    }
+
+    // Ordem aleatória (fixa, para o resultado ser reproduzível) dá tempo linear esperado
+    xoshiro256ss gen(points.size());
+    for(std::size_t i = points.size() - 1; i > 0; --i){
+        std::swap(points[i], points[gen() % (i + 1)]);
+    }
+
+    // Versão iterativa: ao achar um ponto fora, ele passa a ser borda da esfera
+    // dos anteriores, que é refeita com até quatro pontos fixos
+    sphere3D sphere(points[0], 0.0);
+    for(std::size_t i = 1; i < points.size(); ++i){
+        if(covers(sphere, points[i])) continue;
+        sphere = sphere3D(points[i], 0.0);
+        for(std::size_t j = 0; j < i; ++j){
+            if(covers(sphere, points[j])) continue;
+            sphere = sphereFrom(points[i], points[j]);
+            for(std::size_t l = 0; l < j; ++l){
+                if(covers(sphere, points[l])) continue;
+                sphere = sphereFrom(points[i], points[j], points[l]);
+                for(std::size_t m = 0; m < l; ++m){
+                    if(covers(sphere, points[m])) continue;
+                    sphere = sphereFrom(points[i], points[j], points[l], points[m]);
+                }
+            }
+        }
+    }
+    return sphere;
+}
+
+template<typename T>
+sphere3<T> computeSphere(const cloud3<T>& cloud, std::size_t k, int method){
+    if(cloud.begin(k) == cloud.end(k)){
+        return sphere3<T>(vector3<T>(), T(0));
+    }
+
+    sphere3D sphere;
+    switch(method){
+        case SPHERE_RITTER:
+            sphere = ritterSphere(cloud, k);
+            break;
+        case SPHERE_EPOS6:
+            sphere = eposSphere(cloud, k, 3);
+            break;
+        case SPHERE_EPOS14:
+            sphere = eposSphere(cloud, k, 7);
+            break;
+        case SPHERE_EPOS26:
+            sphere = eposSphere(cloud, k, 13);
+            break;
+        case SPHERE_WELZL: {
+            thread_local std::vector<vec3> points;
+            points.clear();
+            for(std::size_t i = cloud.begin(k); i < cloud.end(k); ++i){
+                points.push_back(widen(cloud.point(i)));
+            }
+            sphere = minimumSphere(points);
+            break;
+        }
+        default:
+            sphere = centroidSphere(cloud, k);
+            break;
+    }
+    return narrowSphere<T>(sphere);
+}
+
+template<typename T>
+obb3<T> computeOBB3(const cloud3<T>& cloud, std::size_t k){
+    const T* __restrict x = cloud.x.data();
+    const T* __restrict y = cloud.y.data();
+    const T* __restrict z = cloud.z.data();
+    std::size_t first = cloud.begin(k), last = cloud.end(k);
+    if(first == last){
+        obb3<T> box;
+        box.axes[0] = vector3<T>(1, 0, 0);
+        box.axes[1] = vector3<T>(0, 1, 0);
+        box.axes[2] = vector3<T>(0, 0, 1);
+        return box;
+    }
+    double inv = 1.0 / (last - first);
+
+    double mx = 0.0, my = 0.0, mz = 0.0;
+    for(std::size_t i = first; i < last; ++i){
+        mx += x[i];
+        my += y[i];
+        mz += z[i];
+    }
+    mx *= inv;
+    my *= inv;
+    mz *= inv;
+
+    double xx = 0.0, xy = 0.0, xz = 0.0, yy = 0.0, yz = 0.0, zz = 0.0;
+    for(std::size_t i = first; i < last; ++i){
+        double dx = x[i] - mx, dy = y[i] - my, dz = z[i] - mz;
+        xx += dx * dx;
+        xy += dx * dy;
+        xz += dx * dz;
+        yy += dy * dy;
+        yz += dy * dz;
+        zz += dz * dz;
+    }
+
+    double covariance[3][3] = {{xx * inv, xy * inv, xz * inv}, {xy * inv, yy * inv, yz * inv}, {xz * inv, yz * inv, zz * inv}};
+    double v[3][3];
+    jacobiEigen(covariance, v);
+
+    // Eixos = autovetores; o terceiro é refeito pelo produto vetorial para garantir base
+    // direita. Os eixos são arredondados para T antes das projeções, que usam os mesmos
+    // valores que pointInOBB3 vai usar.
+    vec3 e0(v[0][0], v[1][0], v[2][0]);
+    vec3 e1(v[0][1], v[1][1], v[2][1]);
+    e0.normalize();
+    e1.normalize();
+    vector3<T> u0 = narrow<T>(e0), u1 = narrow<T>(e1), u2 = narrow<T>(e0.cross(e1));
+
+    // Projeções relativas ao centróide (arredondado para T): em float, projetar as
+    // coordenadas absolutas perderia os dígitos do tamanho da caixa quando ela está
+    // longe da origem
+    vector3<T> origin = narrow<T>(vec3(mx, my, mz));
+    obb3<T> box;
+    box.axes[0] = u0;
+    box.axes[1] = u1;
+    box.axes[2] = u2;
+
+    T lo[3], hi[3];
+    projectedExtents3(cloud, first, last, origin, box.axes, lo, hi);
+
+    T reach = std::fabs(origin.x) + std::fabs(origin.y) + std::fabs(origin.z);
+    box.center = origin + u0 * (T(0.5) * (lo[0] + hi[0])) + u1 * (T(0.5) * (lo[1] + hi[1])) + u2 * (T(0.5) * (lo[2] + hi[2]));
+    box.half_sizes = vector3<T>(paddedHalf(lo[0], hi[0], reach), paddedHalf(lo[1], hi[1], reach), paddedHalf(lo[2], hi[2], reach));
+    return box;
+}
+
+template<typename T>
+void computeAABB3s(const cloud3<T>& cloud, std::vector<aabb3<T>>& out, threadPool* pool){
+    out.resize(cloud.subsets());
+    forEachIndex(pool, cloud.subsets(), [&](std::size_t k){
+        out[k] = computeAABB3(cloud, k);
+    });
+}
+
+template<typename T>
+void computeSpheres(const cloud3<T>& cloud, std::vector<sphere3<T>>& out, threadPool* pool, int method){
+    out.resize(cloud.subsets());
+    forEachIndex(pool, cloud.subsets(), [&](std::size_t k){
+        out[k] = computeSphere(cloud, k, method);
+    });
+}
+
+template<typename T>
+void computeOBB3s(const cloud3<T>& cloud, std::vector<obb3<T>>& out, threadPool* pool){
+    out.resize(cloud.subsets());
+    forEachIndex(pool, cloud.subsets(), [&](std::size_t k){
+        out[k] = computeOBB3(cloud, k);
+    });
+}
+
+template<typename T>
+bool overlapAABB3(const aabb3<T>& a, const aabb3<T>& b){
+    return (a.min_x <= b.max_x) & (b.min_x <= a.max_x) &
+           (a.min_y <= b.max_y) & (b.min_y <= a.max_y) &
+           (a.min_z <= b.max_z) & (b.min_z <= a.max_z);
+}
+
+template<typename T>
+bool overlapSpheres(const sphere3<T>& a, const sphere3<T>& b){
+    vector3<T> d = a.first - b.first;
+    T reach = a.second + b.second;
+    return d.dot(d) <= reach * reach;
+}
+
+template<typename T>
+bool overlapOBB3(const obb3<T>& a, const obb3<T>& b){
+    // Ericson, Real-Time Collision Detection 4.4.1: tudo no referencial de a
+    T ea[3] = {a.half_sizes.x, a.half_sizes.y, a.half_sizes.z};
+    T eb[3] = {b.half_sizes.x, b.half_sizes.y, b.half_sizes.z};
+
+    // Folga para arestas quase paralelas (produto vetorial quase nulo)
+    const T epsilon = tolerance3<T>::parallel;
+
+    T R[3][3], AbsR[3][3];
+    for(int i = 0; i < 3; ++i){
+        for(int j = 0; j < 3; ++j){
+            R[i][j] = a.axes[i].dot(b.axes[j]);
+            AbsR[i][j] = std::fabs(R[i][j]) + epsilon;
+        }
+    }
+
+    vector3<T> d = b.center - a.center;
+    T t[3] = {d.dot(a.axes[0]), d.dot(a.axes[1]), d.dot(a.axes[2])};
+
+    // Eixos de a
+    for(int i = 0; i < 3; ++i){
+        T rb = eb[0] * AbsR[i][0] + eb[1] * AbsR[i][1] + eb[2] * AbsR[i][2];
+        if(std::fabs(t[i]) > ea[i] + rb){
+            return false;
+        }
+    }
+
+    // Eixos de b
+    for(int j = 0; j < 3; ++j){
+        T ra = ea[0] * AbsR[0][j] + ea[1] * AbsR[1][j] + ea[2] * AbsR[2][j];
+        if(std::fabs(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]) > ra + eb[j]){
+            return false;
+        }
+    }
+
+    // Produtos vetoriais A_i x B_j
+    for(int i = 0; i < 3; ++i){
+        int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        for(int j = 0; j < 3; ++j){
+            int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            T ra = ea[i1] * AbsR[i2][j] + ea[i2] * AbsR[i1][j];
+            T rb = eb[j1] * AbsR[i][j2] + eb[j2] * AbsR[i][j1];
+            if(std::fabs(t[i2] * R[i1][j] - t[i1] * R[i2][j]) > ra + rb){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename T>
+bool pointInAABB3(const aabb3<T>& box, const vector3<T>& p){
+    return (p.x >= box.min_x) & (p.x <= box.max_x) &
+           (p.y >= box.min_y) & (p.y <= box.max_y) &
+           (p.z >= box.min_z) & (p.z <= box.max_z);
+}
+
+template<typename T>
+bool pointInSphere(const sphere3<T>& sphere, const vector3<T>& p){
+    vector3<T> d = p - sphere.first;
+    return d.dot(d) <= sphere.second * sphere.second;
+}
+
+template<typename T>
+bool pointInOBB3(const obb3<T>& box, const vector3<T>& p){
+    vector3<T> d = p - box.center;
+    bool inside = true;
+    for(int i = 0; i < 3; ++i){
+        inside &= std::fabs(d.dot(box.axes[i])) <= box.half_sizes.component(i);
+    }
+    return inside;
+}
+
+template<typename T>
+aabb3SoA<T>::aabb3SoA(std::pmr::memory_resource* memory):
+    min_x{memory}, min_y{memory}, min_z{memory}, max_x{memory}, max_y{memory}, max_z{memory} {}
+
+template<typename T>
+void aabb3SoA<T>::assign(const std::vector<aabb3<T>>& boxes){
+    std::size_t n = boxes.size();
+    min_x.resize(n);
+    min_y.resize(n);
+    min_z.resize(n);
+    max_x.resize(n);
+    max_y.resize(n);
+    max_z.resize(n);
+
+    for(std::size_t i = 0; i < n; ++i){
+        min_x[i] = boxes[i].min_x;
+        min_y[i] = boxes[i].min_y;
+        min_z[i] = boxes[i].min_z;
+        max_x[i] = boxes[i].max_x;
+        max_y[i] = boxes[i].max_y;
+        max_z[i] = boxes[i].max_z;
+    }
+}
+
+template<typename T>
+std::size_t aabb3SoA<T>::size() const{
+    return min_x.size();
+}
+
+template<typename T>
+void overlapAABB3Batch(const aabb3<T>& box, const aabb3SoA<T>& boxes, std::size_t first, std::size_t last, unsigned char* __restrict mask){
+    const T* __restrict min_x = boxes.min_x.data();
+    const T* __restrict min_y = boxes.min_y.data();
+    const T* __restrict min_z = boxes.min_z.data();
+    const T* __restrict max_x = boxes.max_x.data();
+    const T* __restrict max_y = boxes.max_y.data();
+    const T* __restrict max_z = boxes.max_z.data();
+
+    for(std::size_t k = first; k < last; ++k){
+        mask[k - first] = (box.min_x <= max_x[k]) & (min_x[k] <= box.max_x) &
+                          (box.min_y <= max_y[k]) & (min_y[k] <= box.max_y) &
+                          (box.min_z <= max_z[k]) & (min_z[k] <= box.max_z);
+    }
+}
+
+template<typename T>
+void intersectAABB3s(const std::vector<aabb3<T>>& boxes, std::vector<std::pair<int, int>>& pairs, threadPool* pool, std::pmr::memory_resource* scratch){
+    aabb3SoA<T> soa{scratch};
+    soa.assign(boxes);
+
+    collectPairs(boxes.size(), pairs, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, std::vector<std::pair<int, int>>& out){
+        if(first >= last){
+            return;
+        }
+        thread_local std::vector<unsigned char> mask;
+        mask.resize(last - first);
+        overlapAABB3Batch(boxes[i], soa, first, last, mask.data());
+        for(std::size_t j = first; j < last; ++j){
+            if(mask[j - first]){
+                out.emplace_back(int(i), int(j));
+            }
+        }
+    });
+}
+
+template<typename T>
+void intersectSpheres(const std::vector<sphere3<T>>& spheres, std::vector<std::pair<int, int>>& pairs, threadPool* pool, std::pmr::memory_resource* scratch){
+    collectPairs(spheres.size(), pairs, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, std::vector<std::pair<int, int>>& out){
+        for(std::size_t j = first; j < last; ++j){
+            if(overlapSpheres(spheres[i], spheres[j])){
+                out.emplace_back(int(i), int(j));
+            }
+        }
+    });
+}
+
+template<typename T>
+void intersectOBB3s(const std::vector<obb3<T>>& boxes, std::vector<std::pair<int, int>>& pairs, threadPool* pool, std::pmr::memory_resource* scratch){
+    collectPairs(boxes.size(), pairs, pool, scratch, [&](std::size_t i, std::size_t first, std::size_t last, std::vector<std::pair<int, int>>& out){
+        for(std::size_t j = first; j < last; ++j){
+            if(overlapOBB3(boxes[i], boxes[j])){
+                out.emplace_back(int(i), int(j));
+            }
+        }
+    });
+}
+
+#define INSTANTIATE_VOLUMES3D(T) \
+    template struct cloud3<T>; \
+    template struct aabb3SoA<T>; \
+    template sphere3<T> computeSphere(const cloud3<T>&, std::size_t, int); \
+    template obb3<T> computeOBB3(const cloud3<T>&, std::size_t); \
+    template void computeAABB3s(const cloud3<T>&, std::vector<aabb3<T>>&, threadPool*); \
+    template void computeSpheres(const cloud3<T>&, std::vector<sphere3<T>>&, threadPool*, int); \
+    template void computeOBB3s(const cloud3<T>&, std::vector<obb3<T>>&, threadPool*); \
+    template bool overlapAABB3(const aabb3<T>&, const aabb3<T>&); \
+    template bool overlapSpheres(const sphere3<T>&, const sphere3<T>&); \
+    template bool overlapOBB3(const obb3<T>&, const obb3<T>&); \
+    template bool pointInAABB3(const aabb3<T>&, const vector3<T>&); \
+    template bool pointInSphere(const sphere3<T>&, const vector3<T>&); \
+    template bool pointInOBB3(const obb3<T>&, const vector3<T>&); \
+    template void overlapAABB3Batch(const aabb3<T>&, const aabb3SoA<T>&, std::size_t, std::size_t, unsigned char*); \
+    template void intersectAABB3s(const std::vector<aabb3<T>>&, std::vector<std::pair<int, int>>&, threadPool*, std::pmr::memory_resource*); \
+    template void intersectSpheres(const std::vector<sphere3<T>>&, std::vector<std::pair<int, int>>&, threadPool*, std::pmr::memory_resource*); \
+    template void intersectOBB3s(const std::vector<obb3<T>>&, std::vector<std::pair<int, int>>&, threadPool*, std::pmr::memory_resource*);
+
+INSTANTIATE_VOLUMES3D(double)
+INSTANTIATE_VOLUMES3D(float)
+
+template void convertCloud(const cloud3<double>&, cloud3<float>&);
+template void convertCloud(const cloud3<float>&, cloud3<double>&);
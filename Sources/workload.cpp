@@ -0,0 +1,253 @@
+#include "../Libraries/workload.h"
+#include "../Libraries/random.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const char* shapeNames[] = {"uniform", "gaussian", "anisotropic", "lines", "mixed"};
+
+// Fluxo reservado para os centros de densidade, fora da faixa dos subconjuntos
+const std::uint64_t hotspotStream = ~std::uint64_t(0);
+
+// Tamanho de um subconjunto: Pareto com média meanPoints, limitado a [3, 100 * média]
+int subsetSize(const workloadSpec& spec, xoshiro256ss& gen){
+    if(spec.tailIndex <= 1.0){
+        return std::max(spec.meanPoints, 1);
+    }
+    double scale = spec.meanPoints * (spec.tailIndex - 1.0) / spec.tailIndex;
+    double u = 1.0 - randomUniform(gen, 0.0, 1.0);
+    double size = scale * std::pow(u, -1.0 / spec.tailIndex);
+    return int(std::clamp(size, 3.0, 100.0 * spec.meanPoints));
+}
+
+void fillSubset(std::vector<ponto2D>& sub, int shape, ponto2D center, double radius, xoshiro256ss& gen){
+    double angle = randomUniform(gen, 0.0, 6.283185307179586);
+    ponto2D u(std::cos(angle), std::sin(angle));
+    ponto2D v(-u.y, u.x);
+
+    switch(shape){
+        case WORKLOAD_UNIFORM:
+            for(auto& p : sub){
+                p = ponto2D(center.x + randomUniform(gen, -radius, radius), center.y + randomUniform(gen, -radius, radius));
+            }
+            break;
+        case WORKLOAD_GAUSSIAN:
+            for(auto& p : sub){
+                p = ponto2D(center.x + 0.5 * radius * randomGaussian(gen), center.y + 0.5 * radius * randomGaussian(gen));
+            }
+            break;
+        case WORKLOAD_ANISOTROPIC: {
+            double ratio = randomUniform(gen, 0.05, 0.3);
+            for(auto& p : sub){
+                double a = 0.5 * radius * randomGaussian(gen);
+                double b = 0.5 * radius * ratio * randomGaussian(gen);
+                p = center + u * a + v * b;
+            }
+            break;
+        }
+        default: // WORKLOAD_LINES
+            for(auto& p : sub){
+                double a = randomUniform(gen, -radius, radius);
+                double b = 0.01 * radius * randomGaussian(gen);
+                p = center + u * a + v * b;
+            }
+            break;
+    }
+}
+
+// Base ortonormal aleatória (u, v, w)
+void randomFrame(xoshiro256ss& gen, vec3 frame[3]){
+    vec3 u(randomGaussian(gen), randomGaussian(gen), randomGaussian(gen) + 1e-12);
+    u.normalize();
+    vec3 helper = std::fabs(u.get_x()) < 0.9 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0);
+    vec3 v = helper - helper.projection(u);
+    v.normalize();
+    frame[0] = u;
+    frame[1] = v;
+    frame[2] = u.cross(v);
+}
+
+void fillSubset3D(cloud3SoA& cloud, std::size_t first, std::size_t last, int shape, const vec3& center, double radius, xoshiro256ss& gen){
+    vec3 frame[3];
+    randomFrame(gen, frame);
+
+    double scale[3];
+    switch(shape){
+        case WORKLOAD_UNIFORM:
+        case WORKLOAD_GAUSSIAN:
+            scale[0] = scale[1] = scale[2] = radius;
+            break;
+        case WORKLOAD_ANISOTROPIC:
+            scale[0] = radius;
+            scale[1] = radius * randomUniform(gen, 0.1, 0.5);
+            scale[2] = radius * randomUniform(gen, 0.05, 0.2);
+            break;
+        default: // Retalho plano
+            scale[0] = radius;
+            scale[1] = radius * randomUniform(gen, 0.3, 1.0);
+            scale[2] = 0.01 * radius;
+            break;
+    }
+
+    for(std::size_t i = first; i < last; ++i){
+        double a, b, c;
+        if(shape == WORKLOAD_UNIFORM){
+            a = randomUniform(gen, -1.0, 1.0);
+            b = randomUniform(gen, -1.0, 1.0);
+            c = randomUniform(gen, -1.0, 1.0);
+        }else if(shape == WORKLOAD_LINES){
+            a = randomUniform(gen, -1.0, 1.0);
+            b = randomUniform(gen, -1.0, 1.0);
+            c = randomGaussian(gen);
+        }else{
+            a = 0.5 * randomGaussian(gen);
+            b = 0.5 * randomGaussian(gen);
+            c = 0.5 * randomGaussian(gen);
+        }
+        vec3 p = center + frame[0] * (a * scale[0]) + frame[1] * (b * scale[1]) + frame[2] * (c * scale[2]);
+        cloud.x[i] = p.get_x();
+        cloud.y[i] = p.get_y();
+        cloud.z[i] = p.get_z();
+    }
+}
+
+}
+
+workloadSpec defaultWorkload(int subsets, int meanPoints, double xMin, double xMax, double yMin, double yMax, std::uint64_t seed){
+    return workloadSpec{subsets, meanPoints, WORKLOAD_MIXED, 2.5, 8, xMin, xMax, yMin, yMax, seed};
+}
+
+bool parseWorkloadShape(const char* name, int& shape){
+    for(int k = 0; k <= WORKLOAD_MIXED; ++k){
+        if(std::strcmp(name, shapeNames[k]) == 0){
+            shape = k;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* workloadShapeName(int shape){
+    return (shape >= 0 && shape <= WORKLOAD_MIXED) ? shapeNames[shape] : "?";
+}
+
+std::size_t generateWorkload3D(const workloadSpec& spec, cloud3SoA& cloud, threadPool* pool){
+    if(spec.subsets <= 0){
+        return 0;
+    }
+
+    double width = spec.xMax - spec.xMin;
+    double height = spec.yMax - spec.yMin;
+    double extent = std::min(width, height);
+
+    std::vector<vec3> hotspots;
+    {
+        xoshiro256ss gen = randomStream(spec.seed, hotspotStream);
+        for(int h = 0; h < spec.hotspots; ++h){
+            hotspots.emplace_back(randomUniform(gen, spec.xMin + 0.2 * width, spec.xMax - 0.2 * width),
+                                  randomUniform(gen, spec.yMin + 0.2 * height, spec.yMax - 0.2 * height),
+                                  randomUniform(gen, spec.xMin + 0.2 * width, spec.xMax - 0.2 * width));
+        }
+    }
+
+    // Primeiro os tamanhos (o primeiro número de cada fluxo), para reservar o espaço
+    // de todos os subconjuntos de uma vez; depois cada subconjunto é preenchido no lugar
+    std::size_t firstSubset = cloud.subsets();
+    std::size_t base = cloud.points();
+    for(int k = 0; k < spec.subsets; ++k){
+        xoshiro256ss gen = randomStream(spec.seed, k);
+        base += subsetSize(spec, gen);
+        cloud.offsets.push_back(base);
+    }
+    cloud.x.resize(base);
+    cloud.y.resize(base);
+    cloud.z.resize(base);
+
+    auto build = [&](std::size_t k){
+        xoshiro256ss gen = randomStream(spec.seed, k);
+        int size = subsetSize(spec, gen);
+
+        vec3 center;
+        if(hotspots.empty()){
+            center = vec3(randomUniform(gen, spec.xMin, spec.xMax), randomUniform(gen, spec.yMin, spec.yMax), randomUniform(gen, spec.xMin, spec.xMax));
+        }else{
+            const vec3& h = hotspots[std::size_t(randomUniform(gen, 0.0, double(hotspots.size())))];
+            center = h + vec3(randomGaussian(gen), randomGaussian(gen), randomGaussian(gen)) * (0.1 * extent);
+        }
+
+        double radius = std::min(0.02 * extent * std::cbrt(double(size) / std::max(spec.meanPoints, 1)), 0.25 * extent);
+
+        int shape = spec.shape;
+        if(shape == WORKLOAD_MIXED){
+            shape = int(randomUniform(gen, 0.0, 4.0));
+        }
+
+        fillSubset3D(cloud, cloud.begin(firstSubset + k), cloud.end(firstSubset + k), shape, center, radius, gen);
+    };
+
+    forEachIndex(pool, spec.subsets, build);
+
+    return cloud.points() - cloud.begin(firstSubset);
+}
+
+std::size_t generateWorkload(const workloadSpec& spec, std::vector<std::vector<ponto2D>>& cloud, threadPool* pool){
+    if(spec.subsets <= 0){
+        return 0;
+    }
+
+    double width = spec.xMax - spec.xMin;
+    double height = spec.yMax - spec.yMin;
+    double extent = std::min(width, height);
+
+    std::vector<ponto2D> hotspots;
+    {
+        xoshiro256ss gen = randomStream(spec.seed, hotspotStream);
+        for(int h = 0; h < spec.hotspots; ++h){
+            hotspots.emplace_back(randomUniform(gen, spec.xMin + 0.2 * width, spec.xMax - 0.2 * width),
+                                  randomUniform(gen, spec.yMin + 0.2 * height, spec.yMax - 0.2 * height));
+        }
+    }
+
+    std::size_t first = cloud.size();
+    cloud.resize(first + spec.subsets);
+
+    std::vector<std::size_t> counts(spec.subsets);
+
+    auto build = [&](std::size_t k){
+        xoshiro256ss gen = randomStream(spec.seed, k);
+
+        int size = subsetSize(spec, gen);
+
+        ponto2D center;
+        if(hotspots.empty()){
+            center = ponto2D(randomUniform(gen, spec.xMin, spec.xMax), randomUniform(gen, spec.yMin, spec.yMax));
+        }else{
+            const ponto2D& h = hotspots[std::size_t(randomUniform(gen, 0.0, double(hotspots.size())))];
+            center = ponto2D(h.x + 0.1 * extent * randomGaussian(gen), h.y + 0.1 * extent * randomGaussian(gen));
+        }
+
+        // Subconjuntos maiores também ocupam mais espaço
+        double radius = 0.02 * extent * std::sqrt(double(size) / std::max(spec.meanPoints, 1));
+        radius = std::min(radius, 0.25 * extent);
+
+        int shape = spec.shape;
+        if(shape == WORKLOAD_MIXED){
+            shape = int(randomUniform(gen, 0.0, 4.0));
+        }
+
+        std::vector<ponto2D>& sub = cloud[first + k];
+        sub.resize(size);
+        fillSubset(sub, shape, center, radius, gen);
+        counts[k] = sub.size();
+    };
+
+    forEachIndex(pool, spec.subsets, build);
+
+    std::size_t total = 0;
+    for(std::size_t c : counts){
+        total += c;
+    }
+    return total;
+}
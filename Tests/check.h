@@ -0,0 +1,27 @@
+#pragma once
+#include <iostream>
+
+// Verificações dos programas de Tests/: cada CHECK que falha imprime a expressão e a
+// linha, e checkResult() dá o código de saída (0 se nada falhou) para o 'make test'.
+
+inline int& checkFailures(){
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition) \
+    do{ \
+        if(!(condition)){ \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": falhou " #condition << std::endl; \
+            checkFailures()++; \
+        } \
+    }while(0)
+
+inline int checkResult(const char* name){
+    if(checkFailures() == 0){
+        std::cout << name << ": ok" << std::endl;
+        return 0;
+    }
+    std::cout << name << ": " << checkFailures() << " falhas" << std::endl;
+    return 1;
+}
@@ -0,0 +1,117 @@
+#include "check.h"
+#include "../Libraries/volumes.h"
+#include "../Libraries/workload.h"
+#include "../Libraries/random.h"
+#include <algorithm>
+#include <utility>
+
+// Volumes 2D em float contra os de double (ver volumes.h): os volumes em float contêm
+// os pontos guardados e os originais, e os pares em double também aparecem em float.
+
+namespace {
+
+vec2f narrow(const ponto2D& p){
+    return vec2f(float(p.x), float(p.y));
+}
+
+ponto2D widen(const vec2f& p){
+    return ponto2D(p.x, p.y);
+}
+
+aabb2D widen(const aabb2f& b){
+    return aabb2D{b.min_x, b.min_y, b.max_x, b.max_y};
+}
+
+circle2D widen(const circle2f& c){
+    return circle2D(widen(c.first), c.second);
+}
+
+obb2D widen(const obb2f& b){
+    const auto& [center, half_sizes, U, V] = b;
+    return obb2D(widen(center), widen(half_sizes), widen(U), widen(V));
+}
+
+// Pares i < j que se sobrepõem, em ordem
+template<typename Volume, typename Overlap>
+std::vector<std::pair<int, int>> pairsOf(const std::vector<Volume>& volumes, Overlap overlap){
+    std::vector<std::pair<int, int>> pairs;
+    for(std::size_t i = 0; i < volumes.size(); ++i){
+        for(std::size_t j = i + 1; j < volumes.size(); ++j){
+            if(overlap(volumes[i], volumes[j])){
+                pairs.emplace_back(int(i), int(j));
+            }
+        }
+    }
+    return pairs;
+}
+
+// Pares de 'inner' que faltam em 'outer' (os dois já em ordem)
+std::size_t missing(const std::vector<std::pair<int, int>>& inner, const std::vector<std::pair<int, int>>& outer){
+    std::vector<std::pair<int, int>> difference;
+    std::set_difference(inner.begin(), inner.end(), outer.begin(), outer.end(), std::back_inserter(difference));
+    return difference.size();
+}
+
+// Nuvem centrada longe da origem, onde o arredondamento de float pesa mais
+void checkCloud(double offset, int shape){
+    workloadSpec spec = defaultWorkload(200, 40, offset, offset + 100.0, offset, offset + 100.0, 11);
+    spec.shape = shape;
+    std::vector<std::vector<ponto2D>> cloudD;
+    generateWorkload(spec, cloudD);
+
+    xoshiro256ss gen = randomStream(46, 0);
+    std::vector<aabb2D> boxesD;
+    std::vector<aabb2f> boxesF;
+    std::vector<circle2D> circlesD;
+    std::vector<circle2f> circlesF;
+    std::vector<obb2D> obbsD;
+    std::vector<obb2f> obbsF;
+    std::size_t outsideStored = 0, outsideOriginal = 0;
+    for(const auto& subD : cloudD){
+        std::vector<vec2f> subF(subD.size());
+        std::transform(subD.begin(), subD.end(), subF.begin(), [](const ponto2D& p){ return narrow(p); });
+
+        ponto2D U = normalized(ponto2D(randomUniform(gen, -1.0, 1.0), randomUniform(gen, -1.0, 1.0)));
+        boxesD.push_back(computeAABB2(subD));
+        boxesF.push_back(computeAABB2(subF));
+        circlesD.push_back(computeCircle2(subD));
+        circlesF.push_back(computeCircle2(subF));
+        obbsD.push_back(computeOBB2(subD, U));
+        obbsF.push_back(computeOBB2(subF, narrow(U)));
+
+        aabb2D box = widen(boxesF.back());
+        circle2D circle = widen(circlesF.back());
+        obb2D obb = widen(obbsF.back());
+        for(std::size_t i = 0; i < subD.size(); ++i){
+            outsideStored += !pointInAABB2(boxesF.back(), subF[i]) + !pointInCircle2(circlesF.back(), subF[i]) + !pointInOBB2(obbsF.back(), subF[i]);
+            outsideOriginal += !pointInAABB2(box, subD[i]) + !pointInCircle2(circle, subD[i]) + !pointInOBB2(obb, subD[i]);
+            outsideOriginal += !pointInAABB2(boxesD.back(), subD[i]) + !pointInCircle2(circlesD.back(), subD[i]) + !pointInOBB2(obbsD.back(), subD[i]);
+        }
+    }
+    CHECK(outsideStored == 0);
+    CHECK(outsideOriginal == 0);
+
+    std::vector<std::pair<int, int>> pairsD = pairsOf(boxesD, overlapAABB2<double>);
+    CHECK(!pairsD.empty());
+    CHECK(missing(pairsD, pairsOf(boxesF, overlapAABB2<float>)) == 0);
+    CHECK(missing(pairsOf(circlesD, overlapCircles2<double>), pairsOf(circlesF, overlapCircles2<float>)) == 0);
+    CHECK(missing(pairsOf(obbsD, overlapOBB2<double>), pairsOf(obbsF, overlapOBB2<float>)) == 0);
+}
+
+}
+
+int main(){
+    for(double offset : {0.0, 1e3, 1e5}){
+        for(int shape = WORKLOAD_UNIFORM; shape <= WORKLOAD_MIXED; ++shape){
+            checkCloud(offset, shape);
+        }
+    }
+
+    // Subconjunto vazio: volumes degenerados na origem
+    std::vector<vec2f> empty;
+    CHECK(computeAABB2(empty).max_x == 0.0f);
+    CHECK(computeCircle2(empty).second == 0.0f);
+    CHECK(std::get<1>(computeOBB2(empty, vec2f(1.0f, 0.0f))).x == 0.0f);
+
+    return checkResult("precision2d");
+}
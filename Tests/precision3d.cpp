@@ -0,0 +1,105 @@
+#include "check.h"
+#include "../Libraries/volumes3d.h"
+#include "../Libraries/workload.h"
+#include <algorithm>
+
+// Pipeline 3D em float contra o de double (ver volumes3d.h): os volumes em float contêm
+// os pontos guardados e os originais, e os pares em double também aparecem em float.
+
+namespace {
+
+aabb3D widen(const aabb3f& b){
+    return aabb3D{b.min_x, b.min_y, b.min_z, b.max_x, b.max_y, b.max_z};
+}
+
+sphere3D widen(const sphere3f& s){
+    return sphere3D(vec3(s.first.x, s.first.y, s.first.z), s.second);
+}
+
+obb3D widen(const obb3f& b){
+    obb3D out;
+    out.center = vec3(b.center.x, b.center.y, b.center.z);
+    out.half_sizes = vec3(b.half_sizes.x, b.half_sizes.y, b.half_sizes.z);
+    for(int i = 0; i < 3; ++i){
+        out.axes[i] = vec3(b.axes[i].x, b.axes[i].y, b.axes[i].z);
+    }
+    return out;
+}
+
+// Pares de 'inner' que faltam em 'outer'
+std::size_t missing(std::vector<std::pair<int, int>> inner, std::vector<std::pair<int, int>> outer){
+    std::sort(inner.begin(), inner.end());
+    std::sort(outer.begin(), outer.end());
+    std::vector<std::pair<int, int>> difference;
+    std::set_difference(inner.begin(), inner.end(), outer.begin(), outer.end(), std::back_inserter(difference));
+    return difference.size();
+}
+
+// Nuvem centrada longe da origem, onde o arredondamento de float pesa mais
+void checkCloud(double offset, int shape){
+    workloadSpec spec = defaultWorkload(300, 40, offset, offset + 100.0, offset, offset + 100.0, 7);
+    spec.shape = shape;
+    cloud3SoA cloudD;
+    generateWorkload3D(spec, cloudD);
+    cloud3f cloudF;
+    convertCloud(cloudD, cloudF);
+
+    std::vector<aabb3D> boxesD;
+    std::vector<aabb3f> boxesF;
+    std::vector<sphere3D> spheresD;
+    std::vector<sphere3f> spheresF;
+    std::vector<obb3D> obbsD;
+    std::vector<obb3f> obbsF;
+    computeAABB3s(cloudD, boxesD);
+    computeAABB3s(cloudF, boxesF);
+    computeSpheres(cloudD, spheresD, nullptr, SPHERE_EPOS14);
+    computeSpheres(cloudF, spheresF, nullptr, SPHERE_EPOS14);
+    computeOBB3s(cloudD, obbsD);
+    computeOBB3s(cloudF, obbsF);
+
+    std::size_t outsideStored = 0, outsideOriginal = 0;
+    for(std::size_t k = 0; k < cloudD.subsets(); ++k){
+        aabb3D box = widen(boxesF[k]);
+        sphere3D sphere = widen(spheresF[k]);
+        obb3D obb = widen(obbsF[k]);
+        for(std::size_t i = cloudD.begin(k); i < cloudD.end(k); ++i){
+            vec3f stored = cloudF.point(i);
+            outsideStored += !pointInAABB3(boxesF[k], stored) + !pointInSphere(spheresF[k], stored) + !pointInOBB3(obbsF[k], stored);
+            vec3 original = cloudD.point(i);
+            outsideOriginal += !pointInAABB3(box, original) + !pointInSphere(sphere, original) + !pointInOBB3(obb, original);
+        }
+    }
+    CHECK(outsideStored == 0);
+    CHECK(outsideOriginal == 0);
+
+    std::vector<std::pair<int, int>> pairsD, pairsF;
+    intersectAABB3s(boxesD, pairsD);
+    intersectAABB3s(boxesF, pairsF);
+    CHECK(!pairsD.empty());
+    CHECK(missing(pairsD, pairsF) == 0);
+    intersectSpheres(spheresD, pairsD);
+    intersectSpheres(spheresF, pairsF);
+    CHECK(missing(pairsD, pairsF) == 0);
+    intersectOBB3s(obbsD, pairsD);
+    intersectOBB3s(obbsF, pairsF);
+    CHECK(missing(pairsD, pairsF) == 0);
+}
+
+}
+
+int main(){
+    for(double offset : {0.0, 1e3, 1e5}){
+        for(int shape = WORKLOAD_UNIFORM; shape <= WORKLOAD_MIXED; ++shape){
+            checkCloud(offset, shape);
+        }
+    }
+
+    // Subconjunto vazio: volumes degenerados, sem ler fora da nuvem
+    cloud3f empty;
+    empty.offsets.push_back(0);
+    CHECK(computeAABB3(empty, 0).max_x == 0.0f);
+    CHECK(computeSphere(empty, 0, SPHERE_WELZL).second == 0.0f);
+    CHECK(computeOBB3(empty, 0).half_sizes.x == 0.0f);
+
+    return checkResult("precision3d");
+}
@@ -0,0 +1,93 @@
+#include "check.h"
+#include "../Libraries/predicates.h"
+#include "../Libraries/random.h"
+#include <algorithm>
+#include <cmath>
+
+// Predicados adaptativos: sinais exatos em casos colineares e quase colineares,
+// toques nas extremidades e o ponto de cruzamento de segmentos quase paralelos.
+
+namespace {
+
+// Ponto finito dentro da caixa dos dois segmentos (com folga de arredondamento)
+bool onBoth(const ponto2D& p, const ponto2D& a, const ponto2D& b, const ponto2D& c, const ponto2D& d){
+    const double slack = 1e-12;
+    auto inside = [&](const ponto2D& u, const ponto2D& v){
+        return p.x >= std::min(u.x, v.x) - slack && p.x <= std::max(u.x, v.x) + slack &&
+               p.y >= std::min(u.y, v.y) - slack && p.y <= std::max(u.y, v.y) + slack;
+    };
+    return std::isfinite(p.x) && std::isfinite(p.y) && inside(a, b) && inside(c, d);
+}
+
+}
+
+int main(){
+    // Colineares exatos, mesmo onde o filtro em double não decide
+    CHECK(orient2d(ponto2D(0, 0), ponto2D(1, 1), ponto2D(2, 2)) == 0.0);
+    CHECK(orient2d(ponto2D(0, 0), ponto2D(1, 0), ponto2D(0.5, 1e-300)) > 0.0);
+    CHECK(orient2d(ponto2D(0, 0), ponto2D(1, 0), ponto2D(0.5, -1e-300)) < 0.0);
+
+    // Perto de 1e15 a diferença de um ulp em c tem de aparecer no sinal
+    ponto2D far(1e15, 1e15);
+    ponto2D step(std::nextafter(far.x, 2e15), far.y);
+    CHECK(orient2d(ponto2D(0, 0), ponto2D(1, 1), far) == 0.0);
+    CHECK(orient2d(ponto2D(0, 0), ponto2D(1, 1), step) < 0.0);
+
+    // Antissimetria: trocar a e b troca o sinal
+    xoshiro256ss gen = randomStream(26, 0);
+    for(int i = 0; i < 10000; ++i){
+        ponto2D a(randomUniform(gen, -1, 1), randomUniform(gen, -1, 1));
+        ponto2D b(randomUniform(gen, -1, 1), randomUniform(gen, -1, 1));
+        ponto2D c = a + (b - a) * randomUniform(gen, -2, 2);
+        double ab = orient2d(a, b, c), ba = orient2d(b, a, c);
+        CHECK((ab > 0) == (ba < 0) && (ab == 0) == (ba == 0));
+    }
+
+    ponto2D out;
+
+    // Toque na extremidade
+    CHECK(segmentsIntersect(ponto2D(0, 0), ponto2D(1, 1), ponto2D(1, 1), ponto2D(2, 0)));
+    CHECK(segmentIntersectionPoint(ponto2D(0, 0), ponto2D(1, 1), ponto2D(1, 1), ponto2D(2, 0), out));
+    CHECK(out == ponto2D(1, 1));
+
+    // Extremidade de um no meio do outro
+    CHECK(segmentIntersectionPoint(ponto2D(0, 0), ponto2D(2, 0), ponto2D(1, 0), ponto2D(1, 5), out));
+    CHECK(out == ponto2D(1, 0));
+
+    // Colineares: sobrepostos, encostados e separados
+    CHECK(segmentsIntersect(ponto2D(0, 0), ponto2D(2, 2), ponto2D(1, 1), ponto2D(3, 3)));
+    CHECK(segmentIntersectionPoint(ponto2D(0, 0), ponto2D(2, 2), ponto2D(1, 1), ponto2D(3, 3), out));
+    CHECK(out == ponto2D(1, 1));
+    CHECK(segmentsIntersect(ponto2D(0, 0), ponto2D(1, 1), ponto2D(1, 1), ponto2D(3, 3)));
+    CHECK(!segmentsIntersect(ponto2D(0, 0), ponto2D(1, 1), ponto2D(2, 2), ponto2D(3, 3)));
+    CHECK(!segmentIntersectionPoint(ponto2D(0, 0), ponto2D(1, 1), ponto2D(2, 2), ponto2D(3, 3), out));
+
+    // Paralelos distintos e cruzamento simples
+    CHECK(!segmentsIntersect(ponto2D(0, 0), ponto2D(1, 0), ponto2D(0, 1), ponto2D(1, 1)));
+    CHECK(segmentIntersectionPoint(ponto2D(0, 0), ponto2D(2, 2), ponto2D(0, 2), ponto2D(2, 0), out));
+    CHECK(out == ponto2D(1, 1));
+
+    // Cruzamento quase paralelo em que o determinante em double arredonda para zero
+    // (com -ffp-contract=off): os sinais exatos dizem que cruzam, e o ponto tem de ser finito
+    ponto2D a(-0x1.34a495800dbp-5, -0x1.6895e4b16c73ap-1), b(0x1.fa557c738d028p-2, 0x1.afc971b1f66fp-4);
+    ponto2D c(-0x1.9a987b4e963d7p-5, -0x1.7247ec1a9f278p-1), d(0x1.139fc6784fa7p-2, -0x1.e62eb63e7b34p-3);
+    CHECK(segmentIntersectionPoint(a, b, c, d, out));
+    CHECK(onBoth(out, a, b, c, d));
+
+    // Muitos cruzamentos quase paralelos: todo ponto devolvido está sobre os dois
+    std::size_t wrong = 0;
+    for(int i = 0; i < 200000; ++i){
+        ponto2D p(randomUniform(gen, -1, 1), randomUniform(gen, -1, 1));
+        ponto2D q(randomUniform(gen, -1, 1), randomUniform(gen, -1, 1));
+        ponto2D mid = p + (q - p) * randomUniform(gen, 0.2, 0.8);
+        ponto2D dir = q - p, normal(-dir.y, dir.x);
+        double tilt = 1e-16 * randomUniform(gen, -1, 1);
+        ponto2D r = mid - dir * 0.3 + normal * tilt, s = mid + dir * 0.3 - normal * tilt;
+        if(segmentIntersectionPoint(p, q, r, s, out)){
+            wrong += !onBoth(out, p, q, r, s);
+        }
+    }
+    CHECK(wrong == 0);
+
+    return checkResult("predicates");
+}
@@ -0,0 +1,84 @@
+#include "check.h"
+#include "../Libraries/quantized.h"
+#include "../Libraries/predicates.h"
+#include "../Libraries/workload.h"
+#include <cmath>
+#include <cstdint>
+
+// Nuvem 2D quantizada (ver quantized.h): decodificação a meio passo da original,
+// volumes conservadores que contêm os pontos originais e predicados inteiros iguais
+// aos adaptativos sobre os pontos decodificados.
+
+namespace {
+
+int sign(double value){
+    return (value > 0.0) - (value < 0.0);
+}
+
+template<typename I>
+void checkCloud(const std::vector<std::vector<ponto2D>>& points){
+    quantizedCloud2D<I> quantized;
+    quantizeCloud(points, quantized);
+    CHECK(quantized.subsets() == points.size());
+    CHECK(quantized.bytes() < quantized.points() * sizeof(ponto2D));
+
+    std::vector<aabb2D> boxes;
+    std::vector<circle2D> discs;
+    quantizedAABBs(quantized, boxes);
+    quantizedCircles(quantized, discs);
+
+    std::size_t far = 0, outside = 0;
+    for(std::size_t k = 0; k < points.size(); ++k){
+        CHECK(quantized.end(k) - quantized.begin(k) == points[k].size());
+        for(std::size_t j = 0; j < points[k].size(); ++j){
+            const ponto2D& p = points[k][j];
+            ponto2D decoded = quantized.point(k, quantized.begin(k) + j);
+            far += std::fabs(decoded.x - p.x) > 0.5 * quantized.step || std::fabs(decoded.y - p.y) > 0.5 * quantized.step;
+
+            const aabb2D& box = boxes[k];
+            outside += !(p.x >= box.min_x && p.x <= box.max_x && p.y >= box.min_y && p.y <= box.max_y);
+            outside += distanceSquared(p, discs[k].first) > discs[k].second * discs[k].second;
+        }
+    }
+    CHECK(far == 0);
+    CHECK(outside == 0);
+
+    // Trincas e pares de segmentos seguidos de cada subconjunto
+    std::size_t orientMismatch = 0, segmentMismatch = 0;
+    for(std::size_t k = 0; k < points.size(); ++k){
+        std::size_t first = quantized.begin(k);
+        for(std::size_t i = 0; i + 3 < points[k].size(); ++i){
+            latticePoint a = quantized.lattice(k, first + i), b = quantized.lattice(k, first + i + 1);
+            latticePoint c = quantized.lattice(k, first + i + 2), d = quantized.lattice(k, first + i + 3);
+            ponto2D pa = quantized.point(k, first + i), pb = quantized.point(k, first + i + 1);
+            ponto2D pc = quantized.point(k, first + i + 2), pd = quantized.point(k, first + i + 3);
+            orientMismatch += orientLattice(a, b, c) != sign(orient2d(pa, pb, pc));
+            segmentMismatch += segmentsIntersectLattice(a, b, c, d) != segmentsIntersect(pa, pb, pc, pd);
+        }
+    }
+    CHECK(orientMismatch == 0);
+    CHECK(segmentMismatch == 0);
+}
+
+}
+
+int main(){
+    for(int shape = WORKLOAD_UNIFORM; shape <= WORKLOAD_MIXED; ++shape){
+        std::vector<std::vector<ponto2D>> points;
+        workloadSpec spec = defaultWorkload(200, 30, -500.0, 500.0, -500.0, 500.0, 11);
+        spec.shape = shape;
+        generateWorkload(spec, points);
+        checkCloud<std::int16_t>(points);
+        checkCloud<std::int32_t>(points);
+    }
+
+    // Pontos colineares e segmentos que só se tocam na ponta: casos degenerados exatos
+    std::vector<std::vector<ponto2D>> degenerate = {{ponto2D(0, 0), ponto2D(1, 1), ponto2D(2, 2), ponto2D(1, 1)}};
+    checkCloud<std::int16_t>(degenerate);
+    quantized16 line;
+    quantizeCloud(degenerate, line);
+    CHECK(orientLattice(line.lattice(0, 0), line.lattice(0, 1), line.lattice(0, 2)) == 0);
+    CHECK(segmentsIntersectLattice(line.lattice(0, 0), line.lattice(0, 1), line.lattice(0, 1), line.lattice(0, 2)));
+
+    return checkResult("quantized");
+}
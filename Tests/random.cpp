@@ -0,0 +1,52 @@
+#include "check.h"
+#include "../Libraries/random.h"
+#include <thread>
+#include <vector>
+
+// A cena sorteia em randomStream(semente, 0), que é o que threadRandom() dá à thread
+// que chamou seedRandom: a mesma semente tem de gerar os mesmos números em qualquer
+// thread, como antes de a cena passar para a thread da simulação.
+
+namespace {
+
+std::vector<std::uint64_t> draw(xoshiro256ss& gen, int count){
+    std::vector<std::uint64_t> out;
+    for(int i = 0; i < count; ++i){
+        out.push_back(gen());
+    }
+    return out;
+}
+
+}
+
+int main(){
+    const std::uint64_t seed = 0x5EED;
+
+    seedRandom(seed);
+    std::vector<std::uint64_t> seeding = draw(threadRandom(), 1000);
+
+    std::vector<std::uint64_t> other;
+    std::thread worker([&]{
+        xoshiro256ss gen = randomStream(seed, 0);
+        other = draw(gen, 1000);
+    });
+    worker.join();
+    CHECK(seeding == other);
+
+    // Semear de novo recomeça a sequência
+    seedRandom(seed);
+    CHECK(draw(threadRandom(), 1000) == seeding);
+
+    // Outra thread usando threadRandom() recebe outro fluxo
+    std::vector<std::uint64_t> second;
+    std::thread stream([&]{ second = draw(threadRandom(), 1000); });
+    stream.join();
+    CHECK(second != seeding);
+
+    xoshiro256ss a = randomStream(seed, 1), b = randomStream(seed, 1), c = randomStream(seed + 1, 1);
+    std::vector<std::uint64_t> drawnA = draw(a, 100);
+    CHECK(drawnA == draw(b, 100));
+    CHECK(drawnA != draw(c, 100));
+
+    return checkResult("random");
+}
@@ -0,0 +1,59 @@
+#include "check.h"
+#include "../Libraries/taskgraph.h"
+#include <atomic>
+#include <vector>
+
+// Grafo de tarefas: cada tarefa roda uma vez, depois de todas as suas dependências, e
+// run() só retorna quando todas terminaram. O grafo é local e destruído a cada volta,
+// como deve poder ser logo depois de run() retornar.
+
+int main(){
+    threadPool pool(4);
+
+    for(int round = 0; round < 2000; ++round){
+        taskGraph graph;
+        std::atomic<int> clock{0};
+        std::vector<int> finished(8, -1);
+        auto stamp = [&](int k){
+            return [&, k]{ finished[k] = clock.fetch_add(1); };
+        };
+
+        // Dois ramos independentes que se juntam, mais tarefas soltas
+        std::size_t a = graph.add("a", stamp(0));
+        std::size_t b = graph.add("b", stamp(1), {a});
+        std::size_t c = graph.add("c", stamp(2), {a});
+        std::size_t d = graph.add("d", stamp(3), {b, c});
+        graph.add("e", stamp(4));
+        graph.add("f", stamp(5));
+        std::size_t g = graph.add("g", stamp(6), {d});
+        graph.add("h", stamp(7));
+        graph.depend(g, c);
+        graph.run(pool);
+
+        bool all = true;
+        for(int k : finished){
+            all &= k >= 0;
+        }
+        CHECK(all);
+        CHECK(finished[0] < finished[1] && finished[0] < finished[2]);
+        CHECK(finished[1] < finished[3] && finished[2] < finished[3]);
+        CHECK(finished[3] < finished[6]);
+        if(checkFailures() > 0){
+            break;
+        }
+    }
+
+    // clear() e uma nova execução reaproveitam o grafo
+    taskGraph graph;
+    int runs = 0;
+    for(int round = 0; round < 3; ++round){
+        graph.clear();
+        std::size_t first = graph.add("first", [&]{ runs++; });
+        graph.add("second", [&]{ runs++; }, {first});
+        graph.run(pool);
+    }
+    CHECK(runs == 6);
+    CHECK(graph.size() == 2);
+
+    return checkResult("taskgraph");
+}
@@ -0,0 +1,112 @@
+#include "check.h"
+#include "../Libraries/vecbatch.h"
+#include "../Libraries/random.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Núcleos de vecbatch.h contra as operações escalares de vec3, com a saída em arrays
+// separados (cópia) e na própria entrada (no lugar). n ímpar passa pelas iterações
+// que sobram depois dos blocos vetoriais.
+
+namespace {
+
+struct soa{
+    std::vector<double> x, y, z;
+
+    explicit soa(std::size_t n): x(n), y(n), z(n) {}
+
+    vec3Span span(){ return vec3Span{x.data(), y.data(), z.data(), x.size()}; }
+    vec3 at(std::size_t i) const{ return vec3(x[i], y[i], z[i]); }
+};
+
+soa randomVectors(xoshiro256ss& gen, std::size_t n){
+    soa out(n);
+    for(std::size_t i = 0; i < n; ++i){
+        out.x[i] = randomUniform(gen, -10.0, 10.0);
+        out.y[i] = randomUniform(gen, -10.0, 10.0);
+        out.z[i] = randomUniform(gen, -10.0, 10.0);
+    }
+    return out;
+}
+
+bool near(double a, double b){
+    return std::fabs(a - b) <= 1e-12 * std::max(1.0, std::fabs(b));
+}
+
+bool near(const vec3& a, const vec3& b){
+    return near(a.x, b.x) && near(a.y, b.y) && near(a.z, b.z);
+}
+
+// Confere um núcleo vetorial: 'run' recebe (entrada, saída) e 'expected' dá o vetor i
+template<typename Run, typename Expected>
+void checkMap(const soa& input, Run run, Expected expected){
+    std::size_t n = input.x.size();
+
+    soa copy(n);
+    soa source = input;
+    run(vec3View(source.span()), copy.span());
+    std::size_t wrong = 0;
+    for(std::size_t i = 0; i < n; ++i){
+        wrong += !near(copy.at(i), expected(input.at(i), i));
+    }
+    CHECK(wrong == 0);
+    CHECK(source.x == input.x && source.y == input.y && source.z == input.z);
+
+    soa inPlace = input;
+    run(vec3View(inPlace.span()), inPlace.span());
+    wrong = 0;
+    for(std::size_t i = 0; i < n; ++i){
+        wrong += !near(inPlace.at(i), expected(input.at(i), i));
+    }
+    CHECK(wrong == 0);
+}
+
+void checkSize(xoshiro256ss& gen, std::size_t n){
+    soa a = randomVectors(gen, n), b = randomVectors(gen, n);
+    std::vector<double> out(n);
+
+    batchDot(a.span(), b.span(), out.data());
+    std::size_t wrong = 0;
+    for(std::size_t i = 0; i < n; ++i){
+        wrong += !near(out[i], a.at(i).dot(b.at(i)));
+    }
+    CHECK(wrong == 0);
+
+    batchNorm(a.span(), out.data());
+    wrong = 0;
+    for(std::size_t i = 0; i < n; ++i){
+        wrong += !near(out[i], a.at(i).norma());
+    }
+    CHECK(wrong == 0);
+
+    checkMap(a, [&](const vec3View& in, const vec3Span& to){ batchCross(in, b.span(), to); },
+             [&](const vec3& v, std::size_t i){ return v.cross(b.at(i)); });
+    checkMap(a, [](const vec3View& in, const vec3Span& to){ batchNormalize(in, to); },
+             [](const vec3& v, std::size_t){ vec3 u = v; u.normalize(); return u; });
+
+    const vec3 onto(0.3, -1.2, 2.5);
+    checkMap(a, [&](const vec3View& in, const vec3Span& to){ batchProjection(in, onto, to); },
+             [&](const vec3& v, std::size_t){ return v.projection(onto); });
+
+    checkMap(a, [](const vec3View& in, const vec3Span& to){ batchReflect(in, vec3(0, 0, 1), to); },
+             [](const vec3& v, std::size_t){ return reflect(v, 'z'); });
+    const vec3 normal(1.0, 2.0, -0.5);
+    checkMap(a, [&](const vec3View& in, const vec3Span& to){ batchReflect(in, normal, to); },
+             [&](const vec3& v, std::size_t){ return v - normal * (2.0 * v.dot(normal) / normal.dot(normal)); });
+
+    const vec3 rows[3] = {vec3(0.6, -0.8, 0.0), vec3(0.8, 0.6, 0.0), vec3(0.0, 0.0, 1.0)};
+    const vec3 shift(1.5, -2.0, 0.25);
+    checkMap(a, [&](const vec3View& in, const vec3Span& to){ batchTransform(in, rows, shift, to); },
+             [&](const vec3& v, std::size_t){ return vec3(rows[0].dot(v), rows[1].dot(v), rows[2].dot(v)) + shift; });
+}
+
+}
+
+int main(){
+    xoshiro256ss gen = randomStream(45, 0);
+    for(std::size_t n : {0, 1, 7, 64, 1001}){
+        checkSize(gen, n);
+    }
+    return checkResult("vecbatch");
+}
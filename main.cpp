@@ -1,5 +1,20 @@
 #include "Libraries/vectors.h"
 #include "Libraries/point.h"
+#include "Libraries/predicates.h"
+#include "Libraries/volumes.h"
+#include "Libraries/collision.h"
+#include "Libraries/arena.h"
+#include "Libraries/render.h"
+#include "Libraries/profiler.h"
+#include "Libraries/options.h"
+#include "Libraries/replay.h"
+#include "Libraries/random.h"
+#include "Libraries/workload.h"
+#include "Libraries/hull.h"
+#include "Libraries/selection.h"
+#include "Libraries/lockfree.h"
+#include "Libraries/taskgraph.h"
+#include "Libraries/bench.h"
 #include "glad/include/glad/glad.h"
 #include <GLFW/glfw3.h>
 #include "glm/gtc/matrix_transform.hpp"
@@ -11,6 +26,18 @@
 #include <cstdlib>
 #include <ctime>
 #include <limits>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <string>
 
 // Janela 800x800
 const unsigned int WIDTH = 800;
@@ -31,22 +58,109 @@ struct rgb
 
 //Variáveis Globais
 std::vector<std::vector<ponto2D>> cloud;
-std::vector<std::vector<ponto2D>> aabb;
+std::vector<aabb2D> aabb;
+std::vector<dop8> dops8;   // Calculados junto com as AABBs, só o do kdopMode atual
+std::vector<dop16> dops16;
+int kdopMode = 0;          // k-DOP desenhado e testado: 0 (nenhum), 8 ou 16
 std::vector<ponto2D> mouseInput;
 std::vector<rgb> colors;
-std::vector<std::pair<ponto2D, double>> circles;
-std::vector<std::tuple<ponto2D, ponto2D, ponto2D, ponto2D>> obb;
+std::vector<circle2D> circles;
+std::vector<obb2D> obb;
+std::vector<std::vector<ponto2D>> hulls; // Fecho convexo de cada subconjunto
+std::vector<capsule2D> capsules;
+std::vector<ellipse2D> ellipses;
+std::vector<taggedVolume> autoVolumes;  // Seleção automática: um volume (de qualquer tipo) por subconjunto
+
+// Depois de startSimulation() as variáveis acima só são tocadas pela thread de
+// simulação. O desenho usa apenas o último sceneSnapshot publicado por ela.
+struct sceneSnapshot{
+    std::vector<rgb> colors;
+    std::vector<aabb2D> aabb;
+    std::vector<dop8> dops8;
+    std::vector<dop16> dops16;
+    int kdopMode = 0;
+    std::vector<circle2D> circles;
+    std::vector<obb2D> obb;
+    std::vector<std::vector<ponto2D>> hulls;
+    std::vector<capsule2D> capsules;
+    std::vector<ellipse2D> ellipses;
+    std::vector<taggedVolume> autoVolumes;
+
+    // Camada de pontos pronta: nuvem, cliques coloridos pela pertinência e marcadores
+    // brancos de interseção
+    std::vector<colorVertex> points;
+
+    std::uint64_t appliedEvents = 0;  // Eventos de entrada já refletidos aqui
+};
+
+// Teclas e cliques da thread de renderização para a de simulação
+spscQueue<inputEvent, 1024> sceneInput;
+
+// Comandos de qualquer thread (carregadores de arquivo, rede, interface) para a
+// simulação, que os aplica em lotes
+enum sceneCommandType{
+    COMMAND_ADD_SUBSET = 0,   // Acrescenta 'points' como um novo subconjunto
+    COMMAND_CLEAR = 1,        // Esvazia a cena, como a tecla E
+    COMMAND_REBUILD = 2       // Recalcula os volumes de 'volumes' (rebuildFlags)
+};
+
+enum rebuildFlags{
+    REBUILD_AABB = 1,         // AABBs e k-DOPs
+    REBUILD_CIRCLE = 2,
+    REBUILD_OBB = 4,
+    REBUILD_HULL = 8,
+    REBUILD_CAPSULE = 16,
+    REBUILD_ELLIPSE = 32,
+    REBUILD_AUTO = 64,
+    REBUILD_ALL = 127
+};
+
+struct sceneCommand{
+    int type = COMMAND_REBUILD;
+    unsigned volumes = 0;
+    std::vector<ponto2D> points;
+};
+
+mpmcQueue<sceneCommand, 4096> sceneCommands;
+
+// Máximo de comandos por lote: uma enxurrada não atrasa demais a próxima publicação
+const std::size_t commandBatch = 256;
+tripleBuffer<sceneSnapshot> snapshots;
+
+std::thread simulation;
+std::atomic<bool> simulationRunning{false};
+std::uint64_t sentEvents = 0;                         // Só a thread de renderização
+std::atomic<std::uint64_t> publishedEvents{0};        // appliedEvents da última publicação
+std::atomic<bool> snapshotPublished{false};
+std::atomic<std::uint64_t> postedCommands{0};         // Comandos aceitos por sceneCommands
+std::atomic<std::uint64_t> publishedCommands{0};      // Comandos aplicados até a última publicação
+std::atomic<bool> loaderStop{false};                  // Pede ao carregador de --load que desista
+
+renderer render; // Fila de desenho e cache de estado do OpenGL
+
+// Gravação da entrada (--record); os instantes são relativos a inputClockStart
+inputScript recording;
+bool recordingInput = false;
+double inputClockStart = 0.0;
+
+// Cena sintética da tecla G e de --workload (configurada em main)
+workloadSpec workload;
+volumeCostModel costModel = defaultCostModel();   // Da tecla M (--calibrate, --looseness)
+
+// Sorteios da cena (pontos, cores, eixos da OBB, sementes da tecla G). Só a thread que
+// edita a cena o usa: a da simulação depois que ela começa. É o fluxo 0 da semente, o
+// mesmo que threadRandom() dava à thread principal quando a cena era editada nela,
+// então uma semente gera as mesmas cenas em qualquer thread.
+xoshiro256ss sceneRandom;
 
 // Gera um RGB aleatório
 rgb randomRGB(){
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> distrib(0.0f, 1.0f);
+    xoshiro256ss& gen = sceneRandom;
 
     rgb color;
-    color.red = distrib(gen);
-    color.green = distrib(gen);
-    color.blue = distrib(gen);
+    color.red = randomUniform(gen, 0.0, 1.0);
+    color.green = randomUniform(gen, 0.0, 1.0);
+    color.blue = randomUniform(gen, 0.0, 1.0);
 
     return color;
 }
@@ -56,14 +170,11 @@ void randomPoints(){
     
     std::vector<ponto2D> tmp;
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> distrib_x(xMin, xMax);
-    std::uniform_real_distribution<> distrib_y(yMin, yMax);
+    xoshiro256ss& gen = sceneRandom;
     
     for(int i = 0; i < 5; ++i){
-        double x = distrib_x(gen);
-        double y = distrib_y(gen);
+        double x = randomUniform(gen, xMin, xMax);
+        double y = randomUniform(gen, yMin, yMax);
         tmp.emplace_back(ponto2D(x, y));    
     }
 
@@ -71,46 +182,63 @@ void randomPoints(){
     colors.push_back(randomRGB()); // Cor i é equivalente à cor do subconjunto i de pontos na nuvem.
 }
 
-void calculateAABB(){
-    aabb.clear();
-    for(const auto& sub : cloud){
-        std::vector<ponto2D> tmp;
-    
-        double min_x = std::numeric_limits<double>::infinity();
-        double min_y = std::numeric_limits<double>::infinity();
+// Acrescenta workload.subsets subconjuntos sintéticos de uma vez, gerados em paralelo
+void generateWorkloadSubsets(){
+    PROFILE_SCOPE("generateWorkload");
+    workload.seed = sceneRandom();
 
-        double max_x = -std::numeric_limits<double>::infinity();
-        double max_y = -std::numeric_limits<double>::infinity();
+    std::size_t first = cloud.size();
+    std::size_t total = generateWorkload(workload, cloud, &defaultPool());
+    for(std::size_t k = first; k < cloud.size(); ++k){
+        colors.push_back(randomRGB());
+    }
+    std::cout << "Cena " << workloadShapeName(workload.shape) << ": " << cloud.size() - first << " subconjuntos, " << total << " pontos" << std::endl;
+}
 
-        for(const auto& p : sub){
-            min_x = std::min(min_x, p.x);
-            min_y = std::min(min_y, p.y);
-    
-            max_x = std::max(max_x, p.x);
-            max_y = std::max(max_y, p.y);
+// Só o k-DOP mostrado pela tecla K é calculado; o outro fica vazio
+void calculateKDOPs(){
+    dops8.clear();
+    dops16.clear();
+    if(kdopMode == 8){
+        for(const auto& sub : cloud){
+            dops8.push_back(computeKDOP<4>(sub));
         }
+    }else if(kdopMode == 16){
+        for(const auto& sub : cloud){
+            dops16.push_back(computeKDOP<8>(sub));
+        }
+    }
+}
 
-        tmp.emplace_back(min_x, min_y); // Inferior Esquerdo
-        tmp.emplace_back(max_x, min_y); // Inferior Direito
-
-        tmp.emplace_back(min_x, max_y); // Superior Esquerdo
-        tmp.emplace_back(max_x, max_y); // Superior Direito
+void calculateAABB(){
+    aabb.clear();
+    for(const auto& sub : cloud){
+        aabb.push_back(computeAABB2(sub));
+    }
+    calculateKDOPs();
+}
 
-        aabb.push_back(tmp);
+bool checkBelongsToKDOP(const ponto2D& p){
+    if(kdopMode == 8){
+        for(const auto& dop : dops8){
+            if(pointInKDOP(dop, p)){
+                return true;
+            }
+        }
+    }else if(kdopMode == 16){
+        for(const auto& dop : dops16){
+            if(pointInKDOP(dop, p)){
+                return true;
+            }
+        }
     }
+    return false;
 }
 
 bool checkBelongsToAABB(const ponto2D& p){
 
-    for(const auto& sub : aabb){
-        
-        double min_x = sub[0].x;
-        double min_y = sub[0].y;
-
-        double max_x = sub[3].x;
-        double max_y = sub[3].y;
-
-        if(p.x <= max_x && p.x >= min_x && p.y <= max_y && p.y >= min_y){
+    for(const auto& box : aabb){
+        if(pointInAABB2(box, p)){
             return true;
         }
     }
@@ -118,36 +246,18 @@ bool checkBelongsToAABB(const ponto2D& p){
     return false;
 }
 
-ponto2D calculateCentroid(const std::vector<ponto2D>& sub){
-    double sum_x = 0.0;
-    double sum_y = 0.0;
-    for(const auto& p: sub){
-        sum_x += p.x;
-        sum_y += p.y;
-    }
-
-    return ponto2D{(sum_x/sub.size()), (sum_y/sub.size())};
-}
-
 void calculateCircle(){
     circles.clear();
     for(const auto& sub : cloud){
-        ponto2D centroid = calculateCentroid(sub);
-
-        double raio = -std::numeric_limits<double>::infinity();
-        for(const auto& p : sub){
-            double distancia = centroid.distance(p);
-            if(distancia >= raio){
-                raio = distancia;
-            }
-        }
-        circles.emplace_back(std::make_pair(centroid, raio));
+        circles.push_back(computeCircle2(sub));
     }
 }
 
 // Função para gerar os vértices de um círculo --> Circulo é um Poligono com Infinitos Lados
-std::vector<float> generateCircleVertices(const ponto2D& center, double raio, int numSegments) {
-    std::vector<float> vertices;
+// Os vértices vêm da arena do quadro: não passam pelo heap.
+std::pmr::vector<float> generateCircleVertices(const ponto2D& center, double raio, int numSegments) {
+    std::pmr::vector<float> vertices{&frameScratch()};
+    vertices.reserve(3 * (numSegments + 1));
     for (int i = 0; i <= numSegments; ++i) {
         float angle = 2.0f * M_PI * float(i) / float(numSegments);
         float x = center.x + raio * cos(angle);
@@ -159,91 +269,271 @@ std::vector<float> generateCircleVertices(const ponto2D& center, double raio, in
     return vertices;
 }
 
-void drawCircle(const ponto2D& center, const double& raio, unsigned int shaderProgram, glm::mat4 projection, float red, float green, float blue){
+void drawCircle(const ponto2D& center, const double& raio, float red, float green, float blue){
     
     int numSegments = 100;
-    std::vector<float> vertices = generateCircleVertices(center, raio, numSegments);
+    std::pmr::vector<float> vertices = generateCircleVertices(center, raio, numSegments);
+
+    render.submit(LAYER_VOLUMES, GL_LINE_LOOP, vertices.data(), numSegments + 1, red, green, blue);
+}
 
-    unsigned int VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
+bool checkBelongsToCircle(const ponto2D& p){
+    for(const auto& circle : circles){
+        if(pointInCircle2(circle, p)){
+            return true;
+        }
+    }
+    return false;
+}
 
-    glBindVertexArray(VAO);
+void calculateCapsule(){
+    capsules.clear();
+    for(const auto& sub : cloud){
+        capsules.push_back(fitCapsule(sub));
+    }
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+void calculateEllipse(){
+    ellipses.clear();
+    for(const auto& sub : cloud){
+        ellipses.push_back(fitEllipse(sub));
+    }
+}
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+bool checkBelongsToCapsule(const ponto2D& p){
+    for(const auto& capsule : capsules){
+        if(pointInCapsule(capsule, p)){
+            return true;
+        }
+    }
+    return false;
+}
 
-    glUseProgram(shaderProgram);
+bool checkBelongsToEllipse(const ponto2D& p){
+    for(const auto& ellipse : ellipses){
+        if(pointInEllipse(ellipse, p)){
+            return true;
+        }
+    }
+    return false;
+}
 
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    glUniform3f(glGetUniformLocation(shaderProgram, "color"), red, green, blue);
+// Escolhe, por subconjunto, o volume mais barato entre os suficientemente justos
+void calculateAutoVolumes(){
+    std::size_t histogram[VOLUME_KINDS];
+    selectVolumes(cloud, autoVolumes, costModel, &defaultPool(), histogram);
 
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_LINE_LOOP, 0, numSegments + 1);
+    std::cout << "Selecao automatica:";
+    for(int k = 0; k < VOLUME_KINDS; ++k){
+        std::cout << " " << volumeKindName(k) << " " << histogram[k];
+    }
+    std::cout << std::endl;
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+bool checkBelongsToAutoVolume(const ponto2D& p){
+    for(const auto& v : autoVolumes){
+        if(pointInVolume(v, p)){
+            return true;
+        }
+    }
+    return false;
 }
 
-bool checkBelongsToCircle(const ponto2D& p){
-    for(const auto& circle : circles){
-        ponto2D center = circle.first;
-        double raio = circle.second;
+void calculateHull(){
+    computeHulls(cloud, hulls, &defaultPool());
+}
 
-        if(std::pow(p.x - center.x, 2) + std::pow(p.y - center.y, 2) <= std::pow(raio, 2)){
+bool checkBelongsToHull(const ponto2D& p){
+    for(const auto& hull : hulls){
+        if(pointInConvexPolygon(hull, p)){
             return true;
         }
     }
     return false;
 }
 
-void calculateOBB(){
+// Os eixos U são sorteados em 'gen', um por subconjunto, na ordem da nuvem
+void calculateOBB(xoshiro256ss& gen){
     obb.clear();
-    
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> dist(-1.0, 1.0);
-    
     for(const auto& sub : cloud){
-        ponto2D U(dist(gen), dist(gen));
-        double norm = std::sqrt(U.x * U.x + U.y * U.y);
-        U.x /= norm;
-        U.y /= norm;
-        
-        ponto2D V(-U.y, U.x);
-        
-        double min_u = std::numeric_limits<double>::infinity();
-        double min_v = std::numeric_limits<double>::infinity();
-        double max_u = -std::numeric_limits<double>::infinity();
-        double max_v = -std::numeric_limits<double>::infinity();
-        
-        for(const auto& p : sub){
-            double proj_u = p.x * U.x + p.y * U.y;
-            double proj_v = p.x * V.x + p.y * V.y;
-            
-            min_u = std::min(min_u, proj_u);
-            min_v = std::min(min_v, proj_v);
-            max_u = std::max(max_u, proj_u);
-            max_v = std::max(max_v, proj_v);
+        ponto2D U = normalized(ponto2D(randomUniform(gen, -1.0, 1.0), randomUniform(gen, -1.0, 1.0)));
+        obb.push_back(computeOBB2(sub, U));
+    }
+}
+
+// Recalcula os volumes de 'volumes' (rebuildFlags) ao mesmo tempo, um por tarefa: cada
+// um só lê a nuvem e escreve o seu vetor. A OBB recebe sceneRandom explicitamente e é
+// a única tarefa que sorteia, então o resultado não depende de qual thread a executa.
+taskGraph volumeGraph;
+
+void rebuildVolumes(unsigned volumes){
+    volumeGraph.clear();
+    if(volumes & REBUILD_OBB) volumeGraph.add("calculateOBB", []{ calculateOBB(sceneRandom); });
+    if(volumes & REBUILD_AABB) volumeGraph.add("calculateAABB", calculateAABB);
+    if(volumes & REBUILD_CIRCLE) volumeGraph.add("calculateCircle", calculateCircle);
+    if(volumes & REBUILD_HULL) volumeGraph.add("calculateHull", calculateHull);
+    if(volumes & REBUILD_CAPSULE) volumeGraph.add("calculateCapsule", calculateCapsule);
+    if(volumes & REBUILD_ELLIPSE) volumeGraph.add("calculateEllipse", calculateEllipse);
+    if(volumes & REBUILD_AUTO) volumeGraph.add("selectVolumes", calculateAutoVolumes);
+    volumeGraph.run(defaultPool());
+}
+
+void clearScene(){
+    cloud.clear();
+    aabb.clear();
+    dops8.clear();
+    dops16.clear();
+    mouseInput.clear();
+    circles.clear();
+    obb.clear();
+    hulls.clear();
+    capsules.clear();
+    ellipses.clear();
+    autoVolumes.clear();
+}
+
+// Aplica um evento à cena; roda na thread de simulação
+void applyEvent(const inputEvent& e){
+    if(e.type == EVENT_CLICK){
+        // Clique já em coordenadas de mundo
+        mouseInput.emplace_back(ponto2D{e.x, e.y});
+        return;
+    }
+
+    int key = e.key;
+    if (key == GLFW_KEY_R) {
+        randomPoints();
+    }
+    if (key == GLFW_KEY_G) {
+        generateWorkloadSubsets();
+    }
+    if (key == GLFW_KEY_E) {
+        clearScene();
+    }
+    if (key == GLFW_KEY_A) {
+        rebuildVolumes(REBUILD_AABB);
+    }
+    if (key == GLFW_KEY_C) {
+        rebuildVolumes(REBUILD_CIRCLE);
+    }
+    if (key == GLFW_KEY_O) {
+        rebuildVolumes(REBUILD_OBB);
+    }
+    if (key == GLFW_KEY_S) {
+        rebuildVolumes(REBUILD_CAPSULE);
+    }
+    if (key == GLFW_KEY_L) {
+        rebuildVolumes(REBUILD_ELLIPSE);
+    }
+    if (key == GLFW_KEY_M) {
+        rebuildVolumes(REBUILD_AUTO);
+    }
+    if (key == GLFW_KEY_K) {
+        // Nenhum -> 8-DOP -> 16-DOP -> nenhum
+        kdopMode = kdopMode == 0 ? 8 : (kdopMode == 8 ? 16 : 0);
+        calculateKDOPs();
+    }
+    if (key == GLFW_KEY_H) {
+        rebuildVolumes(REBUILD_HULL);
+    }
+}
+
+// Entrega um evento à thread de simulação. Com a fila cheia (a simulação atrasada em
+// mais de 1024 eventos) espera uma vaga em vez de perder o evento.
+void sendToSimulation(const inputEvent& e){
+    while(!sceneInput.push(e)){
+        std::this_thread::yield();
+    }
+    sentEvents++;
+}
+
+// Enfileiram um comando para a simulação, de qualquer thread e sem bloquear. Retornam
+// false com a fila cheia; quem chamou decide se tenta de novo ou desiste.
+bool postCommand(sceneCommand&& command){
+    if(!sceneCommands.push(std::move(command))){
+        return false;
+    }
+    postedCommands.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+// Só consome 'points' se o comando entrar na fila; com ela cheia os pontos ficam com
+// quem chamou, para a próxima tentativa
+bool postAddSubset(std::vector<ponto2D>&& points){
+    sceneCommand command{COMMAND_ADD_SUBSET, 0, std::move(points)};
+    if(postCommand(std::move(command))){
+        return true;
+    }
+    points = std::move(command.points);
+    return false;
+}
+
+bool postClearScene(){
+    return postCommand(sceneCommand{COMMAND_CLEAR, 0, {}});
+}
+
+bool postRebuild(unsigned volumes){
+    return postCommand(sceneCommand{COMMAND_REBUILD, volumes, {}});
+}
+
+// Aplica até commandBatch comandos como um lote: subconjuntos e limpezas na ordem de
+// chegada, e cada volume pedido é recalculado uma única vez no fim, sobre a cena já
+// com todo o lote. Retorna quantos comandos aplicou.
+std::size_t applyCommandBatch(){
+    sceneCommand command;
+    std::size_t count = 0;
+    unsigned rebuild = 0;
+    while(count < commandBatch && sceneCommands.pop(command)){
+        if(command.type == COMMAND_ADD_SUBSET){
+            if(!command.points.empty()){
+                cloud.push_back(std::move(command.points));
+                colors.push_back(randomRGB());
+            }
+        }else if(command.type == COMMAND_CLEAR){
+            clearScene();
+        }else{
+            rebuild |= command.volumes;
         }
-        
-        double center_u = (min_u + max_u) / 2.0;
-        double center_v = (min_v + max_v) / 2.0;
-        
-        ponto2D center(center_u * U.x + center_v * V.x, 
-                       center_u * U.y + center_v * V.y);
-        
-        ponto2D half_sizes((max_u - min_u) / 2.0, (max_v - min_v) / 2.0);
-        
-        obb.emplace_back(std::make_tuple(center, half_sizes, U, V));
+        count++;
+    }
+
+    if(rebuild != 0){
+        rebuildVolumes(rebuild);
+    }
+    return count;
+}
+
+void handleClick(double x, double y){
+    sendToSimulation(inputEvent{0.0, EVENT_CLICK, 0, x, y});
+}
+
+// Perfil e trace dizem respeito à janela e ficam nesta thread; as outras teclas
+// mudam a cena e vão para a simulação
+void handleKey(GLFWwindow* window, int key){
+    if (key == GLFW_KEY_P) {
+        setProfilingEnabled(!profilingEnabled());
+        if(!profilingEnabled()){
+            glfwSetWindowTitle(window, "Bounding Volume");
+        }
+        return;
+    }
+    if (key == GLFW_KEY_T) {
+        if(writeChromeTrace("trace.json")){
+            std::cout << "Trace salvo em trace.json" << std::endl;
+        }
+        return;
     }
+    sendToSimulation(inputEvent{0.0, EVENT_KEY, key, 0.0, 0.0});
 }
 
+// Aplica um evento gravado como se viesse do GLFW
+void dispatchEvent(GLFWwindow* window, const inputEvent& e){
+    if(e.type == EVENT_KEY){
+        handleKey(window, e.key);
+    }else{
+        handleClick(e.x, e.y);
+    }
+}
 
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
     if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
@@ -252,30 +542,21 @@ void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
         // Mouse --> Coordenadas de Mundo.
         double x = static_cast<double>((xpos / WIDTH) * (xMax - xMin) + xMin);
         double y = static_cast<double>(((HEIGHT - ypos) / HEIGHT) * (yMax - yMin) + yMin);
-        mouseInput.emplace_back(ponto2D{x, y});
+        if(recordingInput){
+            recording.events.push_back(inputEvent{glfwGetTime() - inputClockStart, EVENT_CLICK, 0, x, y});
+        }
+        handleClick(x, y);
     }
 }
 
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-    if (key == GLFW_KEY_R && action == GLFW_PRESS) {
-        randomPoints();
-    }
-    if (key == GLFW_KEY_E && action == GLFW_PRESS) {
-        cloud.clear();
-        aabb.clear();
-        mouseInput.clear();
-        circles.clear();
-        obb.clear();
-    }
-    if (key == GLFW_KEY_A && action == GLFW_PRESS) {
-        calculateAABB();
-    }
-    if (key == GLFW_KEY_C && action == GLFW_PRESS) {
-        calculateCircle();
+    if (action != GLFW_PRESS) {
+        return;
     }
-    if (key == GLFW_KEY_O && action == GLFW_PRESS) {
-        calculateOBB();
+    if(recordingInput){
+        recording.events.push_back(inputEvent{glfwGetTime() - inputClockStart, EVENT_KEY, key, 0.0, 0.0});
     }
+    handleKey(window, key);
 }
 
 unsigned int compileShader(unsigned int type, const char* source) {
@@ -294,352 +575,768 @@ unsigned int compileShader(unsigned int type, const char* source) {
     return shader;
 }
 
-unsigned int setupCartesianPlane(float xMin, float xMax, float yMin, float yMax) {
-    std::array<float, 12> planeVertices = {
+void drawCartesianPlane(float xMin, float xMax, float yMin, float yMax) {
+    float planeVertices[] = {
         xMin, 0.0f, 0.0f,   xMax, 0.0f, 0.0f,  // Eixo X
         0.0f, yMin, 0.0f,   0.0f, yMax, 0.0f   // Eixo Y
     };
 
-    unsigned int vao, vbo;
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(planeVertices), planeVertices.data(), GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
-    return vao;
+    render.submit(LAYER_AXES, GL_LINES, planeVertices, 4, 0.0f, 1.0f, 0.0f);
 }
 
-void drawPoint(const ponto2D& p, unsigned int shaderProgram, glm::mat4 projection, float red, float green, float blue){
-    float pointVertices[] = {
-        p.x, p.y, 0.0f
-    };
-    
-    unsigned int vao, vbo;
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-    
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(pointVertices), pointVertices, GL_STATIC_DRAW);
-    
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    glUniform3f(glGetUniformLocation(shaderProgram, "color"), red, green, blue);
-    
-    glPointSize(7.0f);
-    glDrawArrays(GL_POINTS, 0, 1);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    
-    glDeleteBuffers(1, &vbo);
-    glDeleteVertexArrays(1, &vao);
-}
-
-void drawSegment(const ponto2D& p1, const ponto2D& p2, unsigned int shaderProgram, glm::mat4 projection, float red, float green, float blue) {
+void drawSegment(const ponto2D& p1, const ponto2D& p2, float red, float green, float blue) {
     float lineVertices[] = {
-        p1.x, p1.y, 0.0f,
-        p2.x, p2.y, 0.0f
+        float(p1.x), float(p1.y), 0.0f,
+        float(p2.x), float(p2.y), 0.0f
     };
-    
-    unsigned int vao, vbo;
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-    
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(lineVertices), lineVertices, GL_STATIC_DRAW);
-    
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    glUniform3f(glGetUniformLocation(shaderProgram, "color"), red, green, blue);
-    
-    glDrawArrays(GL_LINES, 0, 2);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    
-    glDeleteBuffers(1, &vbo);
-    glDeleteVertexArrays(1, &vao);
+
+    render.submit(LAYER_VOLUMES, GL_LINES, lineVertices, 2, red, green, blue);
 }
 
-void drawRectangle(unsigned int shaderProgram, glm::mat4 projection){
+void drawRectangle(const sceneSnapshot& scene){
     
-    if((aabb.empty()) || (aabb[0].size() < 4)){
-        std::cout << "Impossivel desenhar 1 Retangulo : Menos que 4 pontos" << std::endl;
+    if(scene.aabb.empty()){
+        std::cout << "Impossivel desenhar 1 Retangulo : Nenhuma caixa encontrada" << std::endl;
         return;
     }
 
-    for(int i = 0; i < aabb.size(); ++i){
+    for(int i = 0; i < scene.aabb.size(); ++i){
         
-        auto sub = aabb[i];
+        const aabb2D& box = scene.aabb[i];
 
-        float r = colors[i].red;
-        float g = colors[i].green;
-        float b = colors[i].blue;
-
-        
-        if(sub.size() != 4){
-            std::cout << "Sub com menos de 4 Pontos" << std::endl;    
-            continue;
-        }
+        float r = scene.colors[i].red;
+        float g = scene.colors[i].green;
+        float b = scene.colors[i].blue;
 
         // Aresta Esquerda
-        drawSegment(sub[0], sub[2], shaderProgram, projection, r, g, b);
+        drawSegment(box.corner(0), box.corner(2), r, g, b);
         // Aresta Direita
-        drawSegment(sub[1], sub[3], shaderProgram, projection, r, g, b);
+        drawSegment(box.corner(1), box.corner(3), r, g, b);
         // Aresta Superior
-        drawSegment(sub[2], sub[3], shaderProgram, projection, r, g, b);
+        drawSegment(box.corner(2), box.corner(3), r, g, b);
         // Aresta Inferior
-        drawSegment(sub[0], sub[1], shaderProgram, projection, r, g, b);
+        drawSegment(box.corner(0), box.corner(1), r, g, b);
     }
 }
 
-void drawOBB(unsigned int shaderProgram, glm::mat4 projection){
-    if(obb.empty()){
+void drawOBB(const sceneSnapshot& scene){
+    if(scene.obb.empty()){
         std::cout << "Impossivel desenhar OBB: Nenhuma caixa encontrada" << std::endl;
         return;
     }
 
-    for(int i = 0; i < obb.size(); ++i){
-        auto [center, half_sizes, U, V] = obb[i];
+    for(int i = 0; i < scene.obb.size(); ++i){
+        auto [center, half_sizes, U, V] = scene.obb[i];
         
-        float r = colors[i].red;
-        float g = colors[i].green;
-        float b = colors[i].blue;
+        float r = scene.colors[i].red;
+        float g = scene.colors[i].green;
+        float b = scene.colors[i].blue;
 
         ponto2D corner1 = center + U * half_sizes.x + V * half_sizes.y;
         ponto2D corner2 = center - U * half_sizes.x + V * half_sizes.y;
         ponto2D corner3 = center - U * half_sizes.x - V * half_sizes.y;
         ponto2D corner4 = center + U * half_sizes.x - V * half_sizes.y;
         
-        drawSegment(corner1, corner2, shaderProgram, projection, r, g, b);
-        drawSegment(corner2, corner3, shaderProgram, projection, r, g, b);
-        drawSegment(corner3, corner4, shaderProgram, projection, r, g, b);
-        drawSegment(corner4, corner1, shaderProgram, projection, r, g, b);
+        drawSegment(corner1, corner2, r, g, b);
+        drawSegment(corner2, corner3, r, g, b);
+        drawSegment(corner3, corner4, r, g, b);
+        drawSegment(corner4, corner1, r, g, b);
     }
 }
 
-ponto2D FindTheIntersectPoint(const ponto2D&a, const ponto2D&b, const ponto2D&c, const ponto2D&d){
-    
-    double det = (b.x - a.x) * (d.y - c.y) - (b.y - a.y) * (d.x - c.x);
+// Contorno da cápsula: meia volta em torno de b e meia volta em torno de a
+void drawCapsule(const capsule2D& capsule, float red, float green, float blue){
+    const int arcSegments = 24;
+    std::pmr::vector<float> vertices{&frameScratch()};
+    vertices.reserve(3 * 2 * (arcSegments + 1));
+
+    ponto2D axis = capsule.b - capsule.a;
+    double start = (axis.x == 0.0 && axis.y == 0.0) ? 0.0 : std::atan2(axis.y, axis.x);
+
+    for(int end = 0; end < 2; ++end){
+        const ponto2D& center = end == 0 ? capsule.b : capsule.a;
+        for(int i = 0; i <= arcSegments; ++i){
+            double angle = start - M_PI / 2.0 + M_PI * (end + double(i) / arcSegments);
+            vertices.push_back(float(center.x + capsule.radius * std::cos(angle)));
+            vertices.push_back(float(center.y + capsule.radius * std::sin(angle)));
+            vertices.push_back(0.0f);
+        }
+    }
+    render.submit(LAYER_VOLUMES, GL_LINE_LOOP, vertices.data(), vertices.size() / 3, red, green, blue);
+}
 
-    double t = ((c.x - a.x) * (d.y - c.y) - (c.y - a.y) * (d.x - c.x)) / det;
-    double u = ((c.x - a.x) * (b.y - a.y) - (c.y - a.y) * (b.x - a.x)) / det;
+void drawEllipse(const ellipse2D& ellipse, float red, float green, float blue){
+    const int numSegments = 64;
+    std::pmr::vector<float> vertices{&frameScratch()};
+    vertices.reserve(3 * numSegments);
+
+    ponto2D V(-ellipse.U.y, ellipse.U.x);
+    for(int i = 0; i < numSegments; ++i){
+        double angle = 2.0 * M_PI * i / numSegments;
+        ponto2D p = ellipse.center + ellipse.U * (ellipse.semi_u * std::cos(angle)) + V * (ellipse.semi_v * std::sin(angle));
+        vertices.push_back(float(p.x));
+        vertices.push_back(float(p.y));
+        vertices.push_back(0.0f);
+    }
+    render.submit(LAYER_VOLUMES, GL_LINE_LOOP, vertices.data(), numSegments, red, green, blue);
+}
 
-    if (t >= 0 && t <= 1 && u >= 0 && u <= 1) {
-        ponto2D intersectionPoint = { a.x + t * (b.x - a.x), a.y + t * (b.y - a.y) };
-        // std::cout << "Ponto de interseção: (" << intersectionPoint.x << ", " << intersectionPoint.y << ")\n";
-        return intersectionPoint; 
+// Volumes da seleção automática, cada um com o desenho do seu tipo
+void drawAutoVolumes(const sceneSnapshot& scene){
+    for(int i = 0; i < scene.autoVolumes.size(); ++i){
+        const taggedVolume& v = scene.autoVolumes[i];
+        float r = scene.colors[i].red;
+        float g = scene.colors[i].green;
+        float b = scene.colors[i].blue;
+
+        switch(v.kind){
+            case VOLUME_AABB:
+            case VOLUME_OBB: {
+                ponto2D V(-v.U.y, v.U.x);
+                ponto2D corner1 = v.center + v.U * v.e0 + V * v.e1;
+                ponto2D corner2 = v.center - v.U * v.e0 + V * v.e1;
+                ponto2D corner3 = v.center - v.U * v.e0 - V * v.e1;
+                ponto2D corner4 = v.center + v.U * v.e0 - V * v.e1;
+                drawSegment(corner1, corner2, r, g, b);
+                drawSegment(corner2, corner3, r, g, b);
+                drawSegment(corner3, corner4, r, g, b);
+                drawSegment(corner4, corner1, r, g, b);
+                break;
+            }
+            case VOLUME_CIRCLE:
+                drawCircle(v.center, v.e0, r, g, b);
+                break;
+            case VOLUME_CAPSULE:
+                drawCapsule(volumeCapsule(v), r, g, b);
+                break;
+            default:
+                drawEllipse(volumeEllipse(v), r, g, b);
+                break;
+        }
     }
+}
 
-    std::cout << "Problema no Ponto de interseção" << std::endl;
-    return ponto2D{0.0, 0.0};
+template<int D>
+void drawKDOPs(const std::vector<kdop2D<D>>& dops, const std::vector<rgb>& colors){
+    for(int i = 0; i < dops.size(); ++i){
+        ponto2D corners[2 * D];
+        int count = kdopVertices(dops[i], corners);
+
+        float vertices[2 * D * 3];
+        for(int k = 0; k < count; ++k){
+            vertices[3 * k] = float(corners[k].x);
+            vertices[3 * k + 1] = float(corners[k].y);
+            vertices[3 * k + 2] = 0.0f;
+        }
+        render.submit(LAYER_VOLUMES, GL_LINE_LOOP, vertices, count, colors[i].red, colors[i].green, colors[i].blue);
+    }
 }
 
-bool checkIntersectSegments(const ponto2D&a, const ponto2D&b, const ponto2D&c, const ponto2D&d){
+// Cada fecho como um GL_LINE_LOOP na cor do seu subconjunto
+void drawHulls(const sceneSnapshot& scene){
+    std::pmr::vector<float> vertices{&frameScratch()};
+    for(int i = 0; i < scene.hulls.size(); ++i){
+        const auto& hull = scene.hulls[i];
+        if(hull.size() < 2){
+            continue;
+        }
 
-    // A função crossProduct(p1, p2, p3) calcula o determinante 
-    // que indica a posição relativa de p3 em relação ao segmento p1p2.
-    auto crossProduct = [](const ponto2D& p1, const ponto2D& p2, const ponto2D& p3) {
-        return (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
+        vertices.clear();
+        for(const auto& p : hull){
+            vertices.push_back(float(p.x));
+            vertices.push_back(float(p.y));
+            vertices.push_back(0.0f);
+        }
+        render.submit(LAYER_VOLUMES, GL_LINE_LOOP, vertices.data(), hull.size(), scene.colors[i].red, scene.colors[i].green, scene.colors[i].blue);
+    }
+}
+
+// Acima disso o triângulo superior de pares é dividido em blocos entre as threads
+const std::size_t parallelPairThreshold = 256;
+
+// Testes de interseção do passo; cada um é uma tarefa de pointGraph
+enum intersectStage{
+    STAGE_AABB = 0,
+    STAGE_KDOP = 1,
+    STAGE_OBB = 2,
+    STAGE_CIRCLE = 3,
+    STAGE_CAPSULE = 4,
+    STAGE_ELLIPSE = 5,
+    STAGE_AUTO = 6,
+    INTERSECT_STAGES = 7
+};
+
+// Temporários da simulação, resetados a cada passo (frameScratch é da thread de
+// renderização). Uma arena por teste, porque eles rodam ao mesmo tempo e a arena
+// não é thread-safe.
+frameArena& simulationScratch(int stage){
+    static frameArena arenas[INTERSECT_STAGES];
+    return arenas[stage];
+}
+
+// Contatos reaproveitados de um passo para o outro (não realocam)
+contactBuffer aabbContacts;
+contactBuffer circleContacts;
+contactBuffer obbContacts;
+contactBuffer kdopContacts;
+contactBuffer capsuleContacts;
+contactBuffer ellipseContacts;
+contactBuffer autoContacts;
+
+const contactBuffer& checkIntersectBetweenAABBs(){
+    // Cada par de caixas é testado uma vez (i < j), pelo retângulo de sobreposição
+    threadPool* pool = aabb.size() >= parallelPairThreshold ? &defaultPool() : nullptr;
+    intersectAABBs(aabb, aabbContacts, pool, &simulationScratch(STAGE_AABB));
+    return aabbContacts;
+}
+
+const contactBuffer& checkIntersectBetweenCircles(){
+    threadPool* pool = circles.size() >= parallelPairThreshold ? &defaultPool() : nullptr;
+    intersectCircles(circles, circleContacts, pool, &simulationScratch(STAGE_CIRCLE));
+    return circleContacts;
+}
+
+const contactBuffer& checkIntersectBetweenOBBs(){
+    threadPool* pool = obb.size() >= parallelPairThreshold ? &defaultPool() : nullptr;
+    intersectOBBs(obb, obbContacts, pool, &simulationScratch(STAGE_OBB));
+    return obbContacts;
+}
+
+const contactBuffer& checkIntersectBetweenCapsules(){
+    threadPool* pool = capsules.size() >= parallelPairThreshold ? &defaultPool() : nullptr;
+    intersectCapsules(capsules, capsuleContacts, pool, &simulationScratch(STAGE_CAPSULE));
+    return capsuleContacts;
+}
+
+const contactBuffer& checkIntersectBetweenEllipses(){
+    threadPool* pool = ellipses.size() >= parallelPairThreshold ? &defaultPool() : nullptr;
+    intersectEllipses(ellipses, ellipseContacts, pool, &simulationScratch(STAGE_ELLIPSE));
+    return ellipseContacts;
+}
+
+const contactBuffer& checkIntersectBetweenAutoVolumes(){
+    threadPool* pool = autoVolumes.size() >= parallelPairThreshold ? &defaultPool() : nullptr;
+    intersectVolumes(autoVolumes, autoContacts, pool, &simulationScratch(STAGE_AUTO));
+    return autoContacts;
+}
+
+// Faixas como fase larga, cruzamentos dos polígonos só para os pares que passam
+const contactBuffer& checkIntersectBetweenKDOPs(){
+    threadPool* pool = cloud.size() >= parallelPairThreshold ? &defaultPool() : nullptr;
+    if(kdopMode == 8){
+        intersectDOP8s(dops8, kdopContacts, pool, &simulationScratch(STAGE_KDOP));
+    }else{
+        intersectDOP16s(dops16, kdopContacts, pool, &simulationScratch(STAGE_KDOP));
+    }
+    return kdopContacts;
+}
+
+void addContactMarkers(std::vector<colorVertex>& points, const contactBuffer& contacts){
+    for(const contact& c : contacts){
+        for(int k = 0; k < c.count; ++k){
+            points.push_back(colorVertex{float(c.points[k].x), float(c.points[k].y), 0.0f, 1.0f, 1.0f, 1.0f});
+        }
+    }
+}
+
+// Estágios da camada de pontos como um grafo de tarefas: os vértices da nuvem, a
+// pertinência dos cliques e cada teste de interseção são independentes e rodam ao
+// mesmo tempo no pool; os marcadores de contato esperam todos. Os dois primeiros
+// escrevem em faixas fixas de 'layerPoints', então a ordem dos vértices não depende
+// de qual tarefa termina antes.
+taskGraph pointGraph;
+std::vector<colorVertex>* layerPoints = nullptr;
+const contactBuffer* layerContacts[INTERSECT_STAGES];
+
+void cloudVertices(){
+    colorVertex* out = layerPoints->data();
+    for(int i = 0; i < cloud.size(); ++i){
+        rgb color = colors[i];
+        for(const auto &p : cloud[i]){
+            *out++ = colorVertex{float(p.x), float(p.y), 0.0f, color.red, color.green, color.blue};
+        }
+    }
+}
+
+void mouseContainment(){
+    colorVertex* out = layerPoints->data() + (layerPoints->size() - mouseInput.size());
+    for(const auto& p : mouseInput){
+        bool inside = checkBelongsToAABB(p) || checkBelongsToCircle(p) || checkBelongsToHull(p) || checkBelongsToKDOP(p) ||
+                      checkBelongsToCapsule(p) || checkBelongsToEllipse(p) || checkBelongsToAutoVolume(p);
+        // Verde: pertence a algum volume; Vermelho: fora de todos
+        float r = inside ? 0.0f : 1.0f;
+        float g = inside ? 1.0f : 0.0f;
+        *out++ = colorVertex{float(p.x), float(p.y), 0.0f, r, g, 0.0f};
+    }
+}
+
+void contactVertices(){
+    // Mesma ordem de antes: AABB, k-DOP, OBB, círculo, cápsula, elipse, automático
+    const int order[] = {STAGE_AABB, STAGE_KDOP, STAGE_OBB, STAGE_CIRCLE, STAGE_CAPSULE, STAGE_ELLIPSE, STAGE_AUTO};
+    for(int stage : order){
+        if(layerContacts[stage] != nullptr){
+            addContactMarkers(*layerPoints, *layerContacts[stage]);
+        }
+    }
+}
+
+// Camada de pontos inteira (nuvem, cliques do mouse e marcadores brancos de
+// interseção) em um único buffer intercalado posição + cor, para um só glDrawArrays.
+// Roda na simulação: os testes de pertinência e de interseção saem do quadro.
+void buildPointLayer(std::vector<colorVertex>& points){
+    PROFILE_SCOPE("build.points");
+
+    std::size_t total = mouseInput.size();
+    for(const auto& sub : cloud){
+        total += sub.size();
+    }
+    points.resize(total);
+    layerPoints = &points;
+    std::fill(std::begin(layerContacts), std::end(layerContacts), nullptr);
+
+    pointGraph.clear();
+    std::size_t contactDeps[INTERSECT_STAGES + 2];
+    std::size_t deps = 0;
+    contactDeps[deps++] = pointGraph.add("vertices.cloud", cloudVertices);
+    contactDeps[deps++] = pointGraph.add("containment", mouseContainment);
+
+    auto intersect = [&](const char* name, int stage, const contactBuffer& (*check)()){
+        contactDeps[deps++] = pointGraph.add(name, [stage, check]{
+            layerContacts[stage] = &check();
+        });
     };
+    if(aabb.size() >= 2){ // Temos que ter pelo menos 2 AABB's
+        intersect("intersect.aabb", STAGE_AABB, checkIntersectBetweenAABBs);
+    }
+    if(dops8.size() >= 2 || dops16.size() >= 2){
+        intersect("intersect.kdop", STAGE_KDOP, checkIntersectBetweenKDOPs);
+    }
+    if(obb.size() >= 2){ // Temos que ter pelo menos 2 OBB's
+        intersect("intersect.obb", STAGE_OBB, checkIntersectBetweenOBBs);
+    }
+    if(circles.size() >= 2){ // Temos que ter pelo menos 2 Circulos
+        intersect("intersect.circle", STAGE_CIRCLE, checkIntersectBetweenCircles);
+    }
+    if(capsules.size() >= 2){
+        intersect("intersect.capsule", STAGE_CAPSULE, checkIntersectBetweenCapsules);
+    }
+    if(ellipses.size() >= 2){
+        intersect("intersect.ellipse", STAGE_ELLIPSE, checkIntersectBetweenEllipses);
+    }
+    if(autoVolumes.size() >= 2){
+        intersect("intersect.auto", STAGE_AUTO, checkIntersectBetweenAutoVolumes);
+    }
 
-    double d1 = crossProduct(a, b, c);
-    double d2 = crossProduct(a, b, d);
-    double d3 = crossProduct(c, d, a);
-    double d4 = crossProduct(c, d, b);
+    std::size_t markers = pointGraph.add("vertices.contacts", contactVertices);
+    for(std::size_t k = 0; k < deps; ++k){
+        pointGraph.depend(markers, contactDeps[k]);
+    }
+    pointGraph.run(defaultPool());
+}
 
-    // Se os produtos cruzados tiverem sinais opostos, os segmentos se cruzam
-    if ((d1 * d2 < 0) && (d3 * d4 < 0)) {
-        return true;
+// Copia a cena para o buffer livre e o publica. As atribuições reaproveitam a memória
+// que o buffer já tinha de publicações anteriores.
+void publishSnapshot(std::uint64_t appliedEvents, std::uint64_t appliedCommands){
+    PROFILE_SCOPE("publish");
+    for(int stage = 0; stage < INTERSECT_STAGES; ++stage){
+        simulationScratch(stage).reset();
     }
 
-    return false;
+    sceneSnapshot& scene = snapshots.writeBuffer();
+    scene.colors = colors;
+    scene.aabb = aabb;
+    scene.dops8 = dops8;
+    scene.dops16 = dops16;
+    scene.kdopMode = kdopMode;
+    scene.circles = circles;
+    scene.obb = obb;
+    scene.hulls = hulls;
+    scene.capsules = capsules;
+    scene.ellipses = ellipses;
+    scene.autoVolumes = autoVolumes;
+    buildPointLayer(scene.points);
+    scene.appliedEvents = appliedEvents;
+
+    snapshots.publish();
+    publishedEvents.store(appliedEvents, std::memory_order_release);
+    publishedCommands.store(appliedCommands, std::memory_order_release);
+    snapshotPublished.store(true, std::memory_order_release);
 }
 
-std::vector<ponto2D> checkIntersectBetweenAABBs(){
-    
-    std::vector<ponto2D> res;
-    
-    int i = 0;
-    int j = 0;
-    for(const auto& sub : aabb){
-        // Para cada Sub --> 4 Arestas
-        // Para cada aresta eu preciso comparar com as outras 4 arestas de cada outra sub de aabb
-
-        ponto2D inferior_esquerdo = sub[0];
-        ponto2D inferior_direito = sub[1];
-
-        ponto2D superior_esquerdo = sub[2];
-        ponto2D superior_direito = sub[3];
-
-        /*
-            // Aresta Esquerda
-            sub[0], sub[2]
-            
-            // Aresta Direita
-            sub[1], sub[3]
-            
-            // Aresta Superior
-            sub[2], sub[3]
-
-            // Aresta Inferior
-            sub[0], sub[1]
-        */
-
-        for(const auto& element : aabb){
-            if(i == j){
-                // Não podemos comparar dois subs iguais
-                // std::cout << "Debug " << i << " | " << j << std::endl;
-                continue;
-            }
+// Laço da thread de simulação: aplica os eventos e um lote de comandos e, se a cena mudou,
+// recalcula pertinência e contatos e publica um novo snapshot. Sem eventos a cena
+// não muda, então a thread só dorme.
+void simulationLoop(){
+    std::uint64_t applied = 0;
+    std::uint64_t commands = 0;
+    publishSnapshot(applied, commands);
+
+    while(simulationRunning.load(std::memory_order_acquire)){
+        inputEvent e;
+        bool changed = false;
+        while(sceneInput.pop(e)){
+            applyEvent(e);
+            applied++;
+            changed = true;
+        }
+        if(std::size_t batch = applyCommandBatch()){
+            commands += batch;
+            changed = true;
+        }
 
-            // Aresta Esquerda - Aresta Esquerda
-            if(checkIntersectSegments(sub[0], sub[2], element[0], element[2])){
-                res.push_back(FindTheIntersectPoint(sub[0], sub[2], element[0], element[2]));
-            }
-            // Aresta Esquerda - Aresta Superior
-            if(checkIntersectSegments(sub[0], sub[2], element[2], element[3])){
-                res.push_back(FindTheIntersectPoint(sub[0], sub[2], element[2], element[3]));
-            }
-            // Aresta Esquerda - Aresta Direita
-            if(checkIntersectSegments(sub[0], sub[2], element[1], element[3])){
-                res.push_back(FindTheIntersectPoint(sub[0], sub[2], element[1], element[3]));
-            }
-            // Aresta Esquerda - Aresta Inferior
-            if(checkIntersectSegments(sub[0], sub[2], element[0], element[1])){
-                res.push_back(FindTheIntersectPoint(sub[0], sub[2], element[0], element[1]));
-            }
+        if(changed){
+            publishSnapshot(applied, commands);
+        }else{
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
 
-            //------------------------
+// A partir daqui a cena pertence à thread de simulação
+void startSimulation(){
+    simulationRunning.store(true, std::memory_order_release);
+    simulation = std::thread(simulationLoop);
+}
 
-            // Aresta Superior - Aresta Esquerda
-            if(checkIntersectSegments(sub[2], sub[3], element[0], element[2])){
-                res.push_back(FindTheIntersectPoint(sub[2], sub[3], element[0], element[2]));
-            }
-            // Aresta Superior - Aresta Superior
-            if(checkIntersectSegments(sub[2], sub[3], element[2], element[3])){
-                res.push_back(FindTheIntersectPoint(sub[2], sub[3], element[2], element[3]));
-            }
-            // Aresta Superior - Aresta Direita
-            if(checkIntersectSegments(sub[2], sub[3], element[1], element[3])){
-                res.push_back(FindTheIntersectPoint(sub[2], sub[3], element[1], element[3]));
-            }
-            // Aresta Superior - Aresta Inferior
-            if(checkIntersectSegments(sub[2], sub[3], element[0], element[1])){
-                res.push_back(FindTheIntersectPoint(sub[2], sub[3], element[0], element[1]));
-            }
+void stopSimulation(){
+    if(simulation.joinable()){
+        simulationRunning.store(false, std::memory_order_release);
+        simulation.join();
+    }
+}
+
+// Espera a simulação aplicar e publicar todos os eventos e comandos já enviados. Só o
+// modo headless usa, para que o quadro N mostre sempre a mesma cena.
+void waitForSimulation(){
+    while(!snapshotPublished.load(std::memory_order_acquire) || publishedEvents.load(std::memory_order_acquire) != sentEvents ||
+          publishedCommands.load(std::memory_order_acquire) != postedCommands.load(std::memory_order_acquire)){
+        std::this_thread::yield();
+    }
+}
 
-            //-----------------------
+// Produtor de --load: lê subconjuntos "x y" (linha em branco separa subconjuntos,
+// '#' comenta) e os envia à simulação enquanto ela roda, depois pede AABBs e círculos.
+// Com a fila cheia espera a simulação esvaziar um lote, sem travar ninguém. Para no
+// meio (retornando false) quando loaderStop é ligado, como ao fechar a janela.
+bool loadSubsets(const char* path){
+    std::ifstream file(path);
+    if(!file){
+        std::cerr << "Nao foi possivel abrir a nuvem " << path << std::endl;
+        return false;
+    }
 
-            // Aresta Direita - Aresta Esquerda
-            if(checkIntersectSegments(sub[1], sub[3], element[0], element[2])){
-                res.push_back(FindTheIntersectPoint(sub[1], sub[3], element[0], element[2]));
+    auto post = [](std::vector<ponto2D>& subset){
+        while(!postAddSubset(std::move(subset))){
+            if(loaderStop.load(std::memory_order_relaxed)){
+                return false;
             }
-            // Aresta Direita - Aresta Superior
-            if(checkIntersectSegments(sub[1], sub[3], element[2], element[3])){
-                res.push_back(FindTheIntersectPoint(sub[1], sub[3], element[2], element[3]));
-            }
-            // Aresta Direita - Aresta Direita
-            if(checkIntersectSegments(sub[1], sub[3], element[1], element[3])){
-                res.push_back(FindTheIntersectPoint(sub[1], sub[3], element[1], element[3]));
-            }
-            // Aresta Direita - Aresta Inferior
-            if(checkIntersectSegments(sub[1], sub[3], element[0], element[1])){
-                res.push_back(FindTheIntersectPoint(sub[1], sub[3], element[0], element[1]));
+            std::this_thread::yield();
+        }
+        subset.clear();
+        return true;
+    };
+
+    std::vector<ponto2D> subset;
+    std::string line;
+    int number = 0;
+    std::size_t loaded = 0;
+    bool ok = true;
+    while(std::getline(file, line)){
+        if(loaderStop.load(std::memory_order_relaxed)){
+            return false;
+        }
+        number++;
+        if(!line.empty() && line[0] == '#'){
+            continue;
+        }
+        if(line.find_first_not_of(" \t\r") == std::string::npos){
+            if(!subset.empty()){
+                if(!post(subset)){
+                    return false;
+                }
+                loaded++;
             }
+            continue;
+        }
 
-            //----------------------
+        std::istringstream in(line);
+        double px, py;
+        if(!(in >> px >> py)){
+            std::cerr << path << ":" << number << ": esperado 'x y'" << std::endl;
+            ok = false;
+            break;
+        }
+        subset.emplace_back(px, py);
+    }
+    if(!subset.empty()){
+        if(!post(subset)){
+            return false;
+        }
+        loaded++;
+    }
 
-            // Aresta Inferior - Aresta Esquerda
-            if(checkIntersectSegments(sub[0], sub[1], element[0], element[2])){
-                res.push_back(FindTheIntersectPoint(sub[0], sub[1], element[0], element[2]));
-            }
-            // Aresta Inferior - Aresta Superior
-            if(checkIntersectSegments(sub[0], sub[1], element[2], element[3])){
-                res.push_back(FindTheIntersectPoint(sub[0], sub[1], element[2], element[3]));
-            }
-            // Aresta Inferior - Aresta Direita
-            if(checkIntersectSegments(sub[0], sub[1], element[1], element[3])){
-                res.push_back(FindTheIntersectPoint(sub[0], sub[1], element[1], element[3]));
-            }
-            // Aresta Inferior - Aresta Inferior
-            if(checkIntersectSegments(sub[0], sub[1], element[0], element[1])){
-                res.push_back(FindTheIntersectPoint(sub[0], sub[1], element[0], element[1]));
-            }
+    while(!postRebuild(REBUILD_AABB | REBUILD_CIRCLE)){
+        if(loaderStop.load(std::memory_order_relaxed)){
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    std::cout << loaded << " subconjuntos carregados de " << path << std::endl;
+    return ok;
+}
+
+// Desenha um quadro completo (eixos, volumes, pontos e marcadores) no framebuffer atual,
+// a partir do snapshot publicado pela simulação
+void renderFrame(const sceneSnapshot& scene){
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    render.beginFrame();
+    render.setProjection(glm::ortho(xMin, xMax, yMin, yMax));
+
+    drawCartesianPlane(xMin, xMax, yMin, yMax);
+
+    {
+        PROFILE_SCOPE("draw.volumes");
+
+        if(!scene.aabb.empty()){
+            drawRectangle(scene);
+        }
+
+        if(!scene.obb.empty()){
+            drawOBB(scene);
+        }
+
+        if(!scene.hulls.empty()){
+            drawHulls(scene);
+        }
 
-            j++;
+        for(int i = 0; i < scene.capsules.size(); ++i){
+            drawCapsule(scene.capsules[i], scene.colors[i].red, scene.colors[i].green, scene.colors[i].blue);
         }
 
-        i++;
-        j = 0;
+        for(int i = 0; i < scene.ellipses.size(); ++i){
+            drawEllipse(scene.ellipses[i], scene.colors[i].red, scene.colors[i].green, scene.colors[i].blue);
+        }
+
+        if(!scene.autoVolumes.empty()){
+            drawAutoVolumes(scene);
+        }
+
+        if(scene.kdopMode == 8){
+            drawKDOPs(scene.dops8, scene.colors);
+        }else if(scene.kdopMode == 16){
+            drawKDOPs(scene.dops16, scene.colors);
+        }
+
+        if(!scene.circles.empty()){
+            for(int i = 0; i < scene.circles.size(); ++i){
+                const auto& circle = scene.circles[i];
+
+                float r = scene.colors[i].red;
+                float g = scene.colors[i].green;
+                float b = scene.colors[i].blue;
+
+                drawCircle(circle.first, circle.second, r, g, b);
+            }
+        }
+    }
+
+    {
+        PROFILE_SCOPE("draw.points");
+        render.submit(LAYER_POINTS, GL_POINTS, scene.points.data(), scene.points.size());
     }
 
-    return res;
+    {
+        PROFILE_SCOPE("render.flush");
+        render.flush();
+    }
 }
 
-std::vector<ponto2D> checkIntersectBetweenCircles(){
-    // Dois circulos colidem se a soma de seus raios for igual (eles se tocam) ou se a soma
-    // for menor (um circulo passa por dentro do outro) à distancia entre seus centros
+// Cena fixa do modo headless: 'subsets' subconjuntos (de 5 pontos uniformes, ou
+// sintéticos com --workload) com os três volumes e uma grade de consultas de pertinência
+void buildScriptedScene(const runOptions& options){
+    if(options.workload >= 0){
+        generateWorkloadSubsets();
+    }else{
+        for(int i = 0; i < options.subsets; ++i){
+            randomPoints();
+        }
+    }
+    rebuildVolumes(REBUILD_AABB | REBUILD_CIRCLE | REBUILD_OBB | REBUILD_HULL | REBUILD_CAPSULE | REBUILD_ELLIPSE);
 
-    std::vector<ponto2D> res;
+    for(int i = 0; i < 10; ++i){
+        for(int j = 0; j < 10; ++j){
+            mouseInput.emplace_back(xMin + (i + 0.5) * (xMax - xMin) / 10.0, yMin + (j + 0.5) * (yMax - yMin) / 10.0);
+        }
+    }
+}
 
-    for(int i = 0; i < circles.size(); ++i){
-        auto circle = circles[i];
+// Renderiza 'frames' quadros em um FBO, sem vsync e sem eventos, e imprime as
+// estatísticas do tempo de quadro. glFinish() garante que o tempo medido inclua a GPU
+// (ou o rasterizador por software do Mesa).
+//
+// Com um roteiro (--replay) a cena vem dos eventos gravados, entregues por um relógio
+// virtual de 60 quadros por segundo: a mesma gravação produz sempre os mesmos quadros,
+// independente de quanto cada um demora.
+int runHeadless(GLFWwindow* window, const runOptions& options, const inputScript* script){
+    unsigned int fbo, colorBuffer;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WIDTH, HEIGHT);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE){
+        std::cerr << "Framebuffer fora da tela incompleto." << std::endl;
+        return -1;
+    }
 
-        for(int j = 0; j < circles.size(); ++j){
-            if(j == i) {continue;}
-            double distancia = circle.first.distance(circles[j].first);
-            if(distancia <= circle.second + circles[j].second && distancia >= std::abs(circle.second - circles[j].second)){
-                // Há Colisão
-                
-                double a = (std::pow(circle.second, 2) - std::pow(circles[j].second, 2) + std::pow(distancia, 2));
-                a /= (2 * distancia);
+    const double frameStep = 1.0 / 60.0;
+    int frameCount = options.frames;
 
-                double h = std::sqrt(std::pow(circle.second, 2) - std::pow(a, 2));
+    std::unique_ptr<inputPlayer> player;
+    if(script != nullptr){
+        player = std::make_unique<inputPlayer>(*script);
+        // Roda pelo menos até o último evento gravado
+        frameCount = std::max(frameCount, int(std::ceil(player->lastEventTime() / frameStep)) + 1);
+    }else{
+        buildScriptedScene(options);
+    }
+    startSimulation();
+    if(options.loadPath != nullptr){
+        // Antes do primeiro quadro, para que a medida não dependa de quando o arquivo termina
+        loadSubsets(options.loadPath);
+    }
 
-                ponto2D p0;
-                p0.x = circle.first.x + (a * (circles[j].first.x - circle.first.x)) / distancia;
-                p0.y = circle.first.y + (a * (circles[j].first.y - circle.first.y)) / distancia;
+    std::vector<double> frameTimes;
+    frameTimes.reserve(frameCount);
+
+    for(int f = 0; f < frameCount; ++f){
+        auto start = std::chrono::steady_clock::now();
+        {
+            scopedTimer frameTimer("frame");
+            if(player){
+                player->dispatchUntil(f * frameStep, [&](const inputEvent& e){
+                    dispatchEvent(window, e);
+                });
+            }
+            waitForSimulation();
+            snapshots.update();
+            frameScratch().reset();
+            renderFrame(snapshots.readBuffer());
+            glFinish();
+        }
+        auto end = std::chrono::steady_clock::now();
+        frameTimes.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    stopSimulation();
 
-                if (h == 0) {
-                    // Um ponto de interseção
-                    res.push_back(p0);
-                } else {
-                    // Dois pontos de interseção
-                    ponto2D p1, p2;
-                    p1.x = p0.x + (h * (circles[j].first.y - circle.first.y)) / distancia;
-                    p1.y = p0.y - (h * (circles[j].first.x - circle.first.x)) / distancia;
+    std::vector<double> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p){
+        return sorted[std::min(sorted.size() - 1, std::size_t(p * (sorted.size() - 1) + 0.5))];
+    };
 
-                    p2.x = p0.x - (h * (circles[j].first.y - circle.first.y)) / distancia;
-                    p2.y = p0.y + (h * (circles[j].first.x - circle.first.x)) / distancia;
+    double total = 0.0;
+    for(double t : frameTimes){
+        total += t;
+    }
+    double mean = total / frameTimes.size();
 
-                    res.push_back(p1);
-                    res.push_back(p2);
-                }
+    std::cout << "Headless: " << frameTimes.size() << " quadros, ";
+    if(script != nullptr){
+        std::cout << "roteiro " << options.replayPath << " (" << script->events.size() << " eventos), ";
+    }else{
+        std::cout << options.subsets << " subconjuntos, ";
+    }
+    std::cout << cloud.size() << " subconjuntos na cena, "
+              << (const char*)glGetString(GL_RENDERER) << std::endl;
+    std::cout << "Tempo de quadro (ms): media " << mean << " | min " << sorted.front()
+              << " | p50 " << percentile(0.50) << " | p95 " << percentile(0.95)
+              << " | p99 " << percentile(0.99) << " | max " << sorted.back() << std::endl;
+    std::cout << "Quadros por segundo: " << 1000.0 / mean << std::endl;
+
+    // Último passo da simulação (a thread já terminou): estágios e em quantas threads rodaram
+    if(pointGraph.size() > 0){
+        std::cout << "Camada de pontos (ms): total " << pointGraph.lastRunMs();
+        const taskTiming& first = pointGraph.timing(0);
+        std::vector<std::size_t> threads;
+        for(std::size_t k = 0; k < pointGraph.size(); ++k){
+            const taskTiming& t = pointGraph.timing(k);
+            std::cout << " | " << t.name << " " << (t.endNs - t.startNs) * 1e-6 << " @" << (t.startNs - first.startNs) * 1e-6;
+            if(std::find(threads.begin(), threads.end(), t.thread) == threads.end()){
+                threads.push_back(t.thread);
             }
         }
+        std::cout << " | " << threads.size() << " threads" << std::endl;
     }
 
-    return res;
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteFramebuffers(1, &fbo);
+    return 0;
 }
 
-int main(){
+int main(int argc, char** argv){
+    runOptions options;
+    if(!parseOptions(argc, argv, options)){
+        return -1;
+    }
+
+    inputScript replay;
+    if(options.replayPath != nullptr && !loadInputScript(options.replayPath, replay)){
+        return -1;
+    }
+
+    // Semente: --seed tem prioridade, depois a do roteiro; sem nenhuma, uma nova por execução
+    unsigned long long seed;
+    if(options.hasSeed){
+        seed = options.seed;
+    }else if(options.replayPath != nullptr){
+        seed = replay.seed;
+    }else{
+        std::random_device rd;
+        seed = (static_cast<unsigned long long>(rd()) << 32) | rd();
+    }
+    seedRandom(seed);
+    sceneRandom = randomStream(seed, 0);
+
+    workload = defaultWorkload(options.subsets, options.points, xMin, xMax, yMin, yMax, seed);
+    if(options.workload >= 0){
+        workload.shape = options.workload;
+    }
+
+    if(options.looseness > 0.0){
+        costModel.maxLooseness = options.looseness;
+    }
+    if(options.calibrate){
+        // Mesma carga dos custos gravados em defaultCostModel
+        std::vector<std::vector<ponto2D>> sample;
+        workloadSpec spec = defaultWorkload(400, 50, xMin, xMax, yMin, yMax, seed);
+        spec.shape = WORKLOAD_MIXED;
+        generateWorkload(spec, sample, &defaultPool());
+        costModel = calibrateCostModel(sample, costModel.maxLooseness);
+
+        std::cout << "Custos por par (AABB = 1):";
+        for(int k = 0; k < VOLUME_KINDS; ++k){
+            std::cout << " " << volumeKindName(k) << " " << costModel.testCost[k];
+        }
+        std::cout << std::endl;
+    }
+
+    recording.seed = seed;
+    recordingInput = options.recordPath != nullptr;
+
+    if(options.bench3d){
+        return runBench3D(options, workload);
+    }
+    if(options.checkPrecision){
+        return runCheckPrecision(options, workload);
+    }
+    if(options.quantizeBits != 0){
+        return runQuantized(options, workload);
+    }
+
     if (!glfwInit()) {
         std::cerr << "Erro ao inicializar GLFW" << std::endl;
         return -1;
@@ -649,6 +1346,10 @@ int main(){
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    if(options.headless){
+        // Janela invisível só para ter um contexto; o desenho vai para um FBO
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
 
     GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "Bounding Volume", nullptr, nullptr);
     if (!window) {
@@ -657,6 +1358,9 @@ int main(){
         return -1;
     }
     glfwMakeContextCurrent(window);
+    if(options.headless){
+        glfwSwapInterval(0);
+    }
     glfwSetMouseButtonCallback(window, mouseButtonCallback);
     glfwSetKeyCallback(window, keyCallback);
 
@@ -670,18 +1374,23 @@ int main(){
     const char* vertexShaderSource = R"(
         #version 430 core
         layout (location = 0) in vec3 aPos;
-        uniform mat4 projection;
+        layout (location = 1) in vec3 aColor;
+        layout (std140, binding = 0) uniform Matrices {
+            mat4 projection;
+        };
+        out vec3 vColor;
         void main() {
             gl_Position = projection * vec4(aPos, 1.0);
+            vColor = aColor;
         }
     )";
 
     const char* fragmentShaderSource = R"(
         #version 430 core
+        in vec3 vColor;
         out vec4 FragColor;
-        uniform vec3 color;
         void main() {
-            FragColor = vec4(color, 1.0);
+            FragColor = vec4(vColor, 1.0);
         }
     )";
         
@@ -703,87 +1412,98 @@ int main(){
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
-    unsigned int cartesianVAO = setupCartesianPlane(xMin, xMax, yMin, yMax);
-
-    while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        glm::mat4 projection = glm::ortho(xMin, xMax, yMin, yMax);
+    // Uniform block da projeção ligado uma única vez, após o link
+    render.init();
+    render.addProgram(shaderProgram);
 
-        glBindVertexArray(cartesianVAO);
-        glUseProgram(shaderProgram);
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-        glUniform3f(glGetUniformLocation(shaderProgram, "color"), 0.0f, 1.0f, 0.0f);
-        glDrawArrays(GL_LINES, 0, 4);
+    const inputScript* script = options.replayPath != nullptr ? &replay : nullptr;
 
-        if(!cloud.empty()){
-            for(int i = 0; i < cloud.size(); ++i){
-                auto sub = cloud[i];
+    if(options.headless){
+        int result = runHeadless(window, options, script);
+        glfwTerminate();
+        return result;
+    }
 
-                rgb color = colors[i];
-                float r = color.red;
-                float g = color.green;
-                float b = color.blue;
+    std::unique_ptr<inputPlayer> player;
+    if(script != nullptr){
+        player = std::make_unique<inputPlayer>(*script);
+    }
 
-                for(const auto &p : sub){
-                    drawPoint(p, shaderProgram, projection, r, g, b);
-                }
+    // Quadros (depois do primeiro) que precisaram do heap. O contador é global, então
+    // inclui o que a simulação alocou durante o quadro; sem eventos o esperado é zero.
+    std::size_t frames = 0;
+    std::size_t framesWithHeap = 0;
+    std::size_t glCallsTotal = 0;
 
-            }
-        }
+    double lastTitleUpdate = 0.0;
+    inputClockStart = glfwGetTime();
+    startSimulation();
 
-        if(!aabb.empty()){
-            drawRectangle(shaderProgram, projection);
-            if(aabb.size() >= 2){ // Temos que ter pelo menos 2 AABB's
-                std::vector<ponto2D> intersects = checkIntersectBetweenAABBs();
+    // A janela já responde enquanto o arquivo é lido
+    std::thread loader;
+    if(options.loadPath != nullptr){
+        loader = std::thread(loadSubsets, options.loadPath);
+    }
 
-                for(const auto& p : intersects){
-                    drawPoint(p, shaderProgram, projection, 1.0f, 1.0f, 1.0f);
-                }
-            }
+    while (!glfwWindowShouldClose(window)) {
+        scopedTimer frameTimer("frame");
+        frameScratch().reset();
+        std::size_t heapBefore = heapAllocationCount();
+
+        if(player){
+            player->dispatchUntil(glfwGetTime() - inputClockStart, [&](const inputEvent& e){
+                dispatchEvent(window, e);
+            });
         }
 
-        if(!obb.empty()){
-            drawOBB(shaderProgram, projection);
+        // Sempre o snapshot mais recente; a simulação nunca faz o quadro esperar
+        snapshots.update();
+        renderFrame(snapshots.readBuffer());
+        glCallsTotal += render.frameStats().glCalls;
+
+        // Percentis (p50/p95 em ms) no título da janela, duas vezes por segundo
+        if(profilingEnabled() && glfwGetTime() - lastTitleUpdate > 0.5){
+            char title[512];
+            std::snprintf(title, sizeof(title), "Bounding Volume | GL %u | ", render.frameStats().glCalls);
+            std::size_t used = std::strlen(title);
+            profileTitle(title + used, sizeof(title) - used);
+            glfwSetWindowTitle(window, title);
+            lastTitleUpdate = glfwGetTime();
         }
 
-        if(!mouseInput.empty()){
-            for(int i = 0; i < mouseInput.size(); ++i){
-                bool b1 = checkBelongsToAABB(mouseInput[i]);
-                bool b2 = checkBelongsToCircle(mouseInput[i]);
-                if(b1 || b2){
-                    drawPoint(mouseInput[i], shaderProgram, projection, 0.0f, 1.0f, 0.0f);
-                }else{
-                    drawPoint(mouseInput[i], shaderProgram, projection, 1.0f, 0.0f, 0.0f);
-                }
-            }
-        }
-
-        if(!circles.empty()){
-            for(int i = 0; i < circles.size(); ++i){
-                auto circle = circles[i];
-
-                float r = colors[i].red;
-                float g = colors[i].green;
-                float b = colors[i].blue;
-
-                drawCircle(circle.first, circle.second, shaderProgram, projection, r, g, b);
-            }
-
-            if(circles.size() >= 2){ // Temos que ter pelo menos 2 Circulos
-                std::vector<ponto2D> intersects = checkIntersectBetweenCircles();
-
-                for(const auto& p : intersects){
-                    drawPoint(p, shaderProgram, projection, 1.0f, 1.0f, 1.0f);
-                }
-            }
+        if(frames++ > 0 && heapAllocationCount() != heapBefore){
+            framesWithHeap++;
         }
 
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
+    // Um arquivo grande pode ainda estar sendo lido: o carregador para no próximo envio
+    if(loader.joinable()){
+        loaderStop.store(true, std::memory_order_relaxed);
+        loader.join();
+    }
+    stopSimulation();
     glfwTerminate();
 
+    if(recordingInput){
+        if(saveInputScript(options.recordPath, recording)){
+            std::cout << recording.events.size() << " eventos gravados em " << options.recordPath << " (semente " << seed << ")" << std::endl;
+        }
+    }
+
+    predicateStats stats = getPredicateStats();
+    std::cout << "orient2d: " << stats.fast << " resolvidos pelo filtro, " << stats.exact << " exatos" << std::endl;
+
+    arenaStats arena = frameScratch().getStats();
+    std::cout << "Arena do quadro: pico de " << arena.peakBytes << " bytes, " << arena.upstreamBlocks << " blocos pedidos ao heap" << std::endl;
+    if(heapAllocationCounting){
+        std::cout << "Quadros que alocaram no heap: " << framesWithHeap << " de " << frames << std::endl;
+    }
+    if(frames > 0){
+        std::cout << "Chamadas GL por quadro (media): " << glCallsTotal / frames << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file